@@ -7,16 +7,20 @@
                         coordinating the grid of components.
     Due Date:           4/25/2018
     Date Created:       3/16/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #include <iomanip>               // setprecision, fixed, left
+#include <iostream>              // cerr
+#include <memory>                // unique_ptr class
 #include <cmath>                 // pow, sqrt
 #include <regex>                 // reg, smatch, regex_search, .size(), .str()
 #include <sstream>               // stringstream class, .str()
 #include "ApplicationManager.h"
+#include "BinaryCircuitFile.h"
 #include "ComponentTypes.h"
-#include "Calculator.h"
+#include "SolverWorker.h"
+#include "SpiceFile.h"
 
 ApplicationManager::ApplicationManager(sf::VideoMode mode, std::string windowTitle, sf::Uint32 style) :
     window(mode, windowTitle, style) {
@@ -32,33 +36,46 @@ ApplicationManager::ApplicationManager(sf::VideoMode mode, std::string windowTit
     // Limit fps to 60
     window.setFramerateLimit(60);
 
-	// Initialize textures
-	sf::Texture resistor,
-				vSrc,
-                error;
+    // Initialize textures. The component glyphs are packed into the batch's
+    // atlas.
+    batch.loadTextures("assets/resistor.png", "assets/vsrc.png");
+    errorTexture.loadFromFile("assets/error.png");
 
-    resistor.loadFromFile("assets/resistor.png");
-    vSrc.loadFromFile("assets/vsrc.png");
-    error.loadFromFile("assets/error.png");
-
-	textures.push_back(resistor);
-	textures.push_back(vSrc);
-    textures.push_back(error);
+    // Create the texture the GUI panels are drawn to
+    guiLayer.create(SCREEN_WIDTH, SCREEN_HEIGHT);
 };
 
 void ApplicationManager::update() {
-    // Clear the window and fill the background with BACKGROUND_COLOR
-	window.clear(BACKGROUND_COLOR);
+	sf::Event event;
+
+    // When rendering on demand and nothing has changed, sleep until the next
+    // event instead of redrawing the same frame. While a solve is running,
+    // sleep until it finishes instead, checking for events every so often.
+    if (!CONTINUOUS_RENDERING && !sceneChanged) {
+        if (solving)
+            worker.waitForResult(SOLVE_WAIT_MILLISECONDS);
+        else if (window.waitEvent(event))
+            handleEvent(event);
+    }
 
     // Poll for events
-	sf::Event event;
 	while (window.pollEvent(event)) {
 		handleEvent(event);
 	}
 
+    // Show the values of a finished solve
+    collectSolveResult();
+
+    if (!CONTINUOUS_RENDERING && !sceneChanged)
+        return;
+
+    // Clear the window and fill the background with BACKGROUND_COLOR
+	window.clear(BACKGROUND_COLOR);
+
     // Draw the state
 	draw();
 	window.display();
+    sceneChanged = false;
 }
 
 ////////////////////////
@@ -66,6 +83,11 @@ void ApplicationManager::update() {
 ////////////////////////
 
 void ApplicationManager::handleEvent(sf::Event event) {
+    // Any event other than moving the mouse may change what is shown (or, for
+    // focus and resize events, may have invalidated the window's contents)
+    if (event.type != sf::Event::MouseMoved)
+        sceneChanged = true;
+
     // Direct the events to the proper handler method
 	switch (event.type) {
         case sf::Event::KeyPressed:
@@ -77,6 +99,15 @@ void ApplicationManager::handleEvent(sf::Event event) {
 		case sf::Event::MouseButtonPressed:
 			handleMousePressed(event.mouseButton);
 			break;
+        case sf::Event::MouseButtonReleased:
+            handleMouseReleased(event.mouseButton);
+            break;
+        case sf::Event::MouseMoved:
+            handleMouseMoved(event.mouseMove);
+            break;
+        case sf::Event::MouseWheelScrolled:
+            handleMouseScrolled(event.mouseWheelScroll);
+            break;
         case sf::Event::Resized:
             handleResized(event.size);
             break;
@@ -90,6 +121,9 @@ void ApplicationManager::handleKeypress(sf::Event::KeyEvent event) {
     // Extract the keyboard id from the event
     sf::Keyboard::Key key = event.code;
 
+    // Most keys change the mode or the selected type, so redraw the panels
+    guiChanged = true;
+
     switch (key) {
         case sf::Keyboard::Escape:
             // Close the window
@@ -98,7 +132,8 @@ void ApplicationManager::handleKeypress(sf::Event::KeyEvent event) {
         case sf::Keyboard::Up:
         case sf::Keyboard::Down:
             // Shift the currently selected component type
-            shift(placingComponentType, key);
+            shift(placingComponentType, key == sf::Keyboard::Up ? 
+                  ShiftDirection::UP : ShiftDirection::DOWN);
             break;
         case sf::Keyboard::Space:
             // Toggle between PLACING and SELECTING mode
@@ -110,19 +145,34 @@ void ApplicationManager::handleKeypress(sf::Event::KeyEvent event) {
             break;
         case sf::Keyboard::C:
             // Clear all components
-            grid.clearComponents();
+            clearGrid();
+            componentsChanged = true;
             recalculate();
             break;
         case sf::Keyboard::S:
-            // Enter TYPING mode, only if the component is not a wire
-            if (mode == SELECTED && selectedComponent->type != &WIRE)
+            // Save the circuit with Ctrl+S. Else, enter TYPING mode, only if
+            // the component is not a wire
+            if (event.control)
+                saveCircuit();
+            else if (mode == SELECTED && selectedComponent->type != &WIRE)
                 mode = TYPING;
             break;
+        case sf::Keyboard::O:
+            // Load the saved circuit with Ctrl+O
+            if (event.control)
+                loadCircuit();
+            break;
+        case sf::Keyboard::E:
+            // Export the circuit as a SPICE netlist with Ctrl+E
+            if (event.control)
+                exportCircuit();
+            break;
         case sf::Keyboard::D:
             // Delete the selected components
             if (mode == SELECTED) {
                 grid.removeComponent(selectedComponent);
                 selectedComponent = nullptr;
+                componentsChanged = true;
                 recalculate();
             }
             break;
@@ -131,6 +181,9 @@ void ApplicationManager::handleKeypress(sf::Event::KeyEvent event) {
 
 void ApplicationManager::handleTextEntered(sf::Event::TextEvent event) {
     if (mode == TYPING) {
+        // The input is shown in the instruction panel
+        guiChanged = true;
+
         // Get the key pressed from the event
         char ch = char(event.unicode);
 
@@ -158,27 +211,25 @@ void ApplicationManager::handleMousePressed(sf::Event::MouseButtonEvent event) {
 	if ((mode == PLACING || mode == PLACING_COMPONENT) && event.button == sf::Mouse::Left) {
         // Place a component
 
-        // Get nearest grid spot, this will be the position that the component
-        // is placed.
-		GridSpot* spot = nullptr;
+        // Get nearest lattice point, this will be the position that the
+        // component is placed.
+		sf::Vector2i point;
 		sf::Vector2i mousePos = sf::Mouse::getPosition(window);
-		grid.getNearestSpot(mousePos, spot);
+		bool onGrid = grid.getNearestPoint(mousePos, point);
 
-		if (mode == PLACING && spot != nullptr) {
-            // Mode is placing; create a new component
-			placingComponent = new Component(placingComponentType);
-			placingComponent->positive = spot;
+		if (mode == PLACING && onGrid) {
+            // Mode is placing; remember where the component starts
+			placingStart = point;
             mode = PLACING_COMPONENT;
-		} else if (mode == PLACING_COMPONENT && spot != nullptr) {
+            guiChanged = true;
+		} else if (mode == PLACING_COMPONENT && onGrid) {
             // A component is already in the process of being placed; complete
             // it
-			placingComponent->negative = spot;
-
-			grid.addComponent(placingComponent);
-			spot->components.push_back(placingComponent);
-            placingComponent->positive->components.push_back(placingComponent);
+			grid.addComponent(new Component(placingComponentType), placingStart, point);
+            componentsChanged = true;
 
             mode = PLACING;
+            guiChanged = true;
 
             // The state has changed, so the component values must be updated
             recalculate();
@@ -191,10 +242,40 @@ void ApplicationManager::handleMousePressed(sf::Event::MouseButtonEvent event) {
             component->type != &WIRE) {
             selectedComponent = component;
             mode = SELECTED;
+            guiChanged = true;
         }
+    } else if (event.button == sf::Mouse::Middle) {
+        // Start dragging the grid
+        panning = true;
+        panPosition = { event.x, event.y };
     }
 }
 
+void ApplicationManager::handleMouseReleased(sf::Event::MouseButtonEvent event) {
+    if (event.button == sf::Mouse::Middle)
+        panning = false;
+}
+
+void ApplicationManager::handleMouseMoved(sf::Event::MouseMoveEvent event) {
+    // The mouse only affects the scene while dragging the grid, placing the
+    // second end of a component, or hovering over components to select them
+    if (panning || mode == PLACING_COMPONENT || mode == SELECTING || mode == SELECTED)
+        sceneChanged = true;
+
+    if (panning) {
+        grid.pan(sf::Vector2f(float(event.x - panPosition.x), float(event.y - panPosition.y)));
+        panPosition = { event.x, event.y };
+    }
+}
+
+void ApplicationManager::handleMouseScrolled(sf::Event::MouseWheelScrollEvent event) {
+    sf::Vector2i point;
+
+    // Each step of the wheel zooms by a tenth, around the cursor
+    if (event.wheel == sf::Mouse::VerticalWheel && grid.getNearestPoint({ event.x, event.y }, point))
+        grid.zoom(float(pow(1.1, double(event.delta))), { event.x, event.y });
+}
+
 void ApplicationManager::handleResized(sf::Event::SizeEvent event) {
     // Set SFML window view
     window.setView(sf::View(sf::FloatRect(0.0f, 0.0f, float(event.width), 
@@ -203,35 +284,14 @@ void ApplicationManager::handleResized(sf::Event::SizeEvent event) {
     // Recalculate Config values
     set(event.width, event.height);
 
-    // Store components, along with the x and y index of their location
-    std::vector<std::tuple<int, int, int, int, Component*>> components;
-
-    for (Component* component : grid.getComponents()) {
-        int x1 = component->positive->x,
-            y1 = component->positive->y,
-            x2 = component->negative->x,
-            y2 = component->negative->y;
-
-        components.push_back(std::make_tuple(x1, y1, x2, y2, component));
-    }
-
-    // Redraw grid
-    grid = Grid(event.width, event.height);
-
-    // Re-add existing components
-    for (auto t : components) {
-        GridSpot* pos,
-                * neg;
-        Component* comp = std::get<4>(t);
-
-        grid.getNearestSpot(sf::Vector2i{ std::get<0>(t), std::get<1>(t) }, pos);
-        grid.getNearestSpot(sf::Vector2i{ std::get<2>(t), std::get<3>(t) }, neg);
+    // Fit the grid to the window. The components stay at the same lattice
+    // points, so the circuit does not change.
+    grid.resize(event.width, event.height);
 
-        comp->positive = pos;
-        comp->negative = neg;
-
-        grid.addComponent(comp);
-    }
+    // The panels are laid out for the window size, so they are redrawn into
+    // a texture of the new size
+    guiLayer.create(event.width, event.height);
+    guiChanged = true;
 }
 
 ///////////////////////
@@ -239,62 +299,95 @@ void ApplicationManager::handleResized(sf::Event::SizeEvent event) {
 ///////////////////////
 
 void ApplicationManager::draw() {
-    // Draw the GUI
-	drawGui();
+    // Draw the GUI. The panels only change with the mode, the selected
+    // component and the window size, so they are drawn into guiLayer once
+    // and copied to the window every frame.
+    if (guiChanged) {
+        guiLayer.clear(BACKGROUND_COLOR);
+        drawGui(guiLayer);
+        guiLayer.display();
+        guiChanged = false;
+    }
+
+    window.draw(sf::Sprite(guiLayer.getTexture()));
+
+    // Rebuild the component vertices only if a component was added or
+    // removed; panning and zooming only change the transform they are drawn
+    // with
+    if (componentsChanged) {
+        batch.rebuild(grid.getComponents());
+        componentsChanged = false;
+    }
 
     // Get the component under the mouse. Only used for determining colors of
     // drawn components.
-    Component* comp;
+    Component* comp = nullptr;
     sf::Vector2i mousePos(sf::Mouse::getPosition(window));
-    grid.getComponentUnderPosition(mousePos, comp);
-    sf::Color color;
-
-    // Loop over all component and draw them with the appropriate color
-	for (Component* component : grid.getComponents()) {
-        if ((mode == SELECTING || mode == SELECTED) && component == selectedComponent)
-            color = COMPONENT_SELECTED_COLOR;
-        else if ((mode == SELECTING || mode == SELECTED) && component == comp
-                 && component->type != &WIRE)
-            color = COMPONENT_HOVER_COLOR;
-        else
-            color = COMPONENT_COLOR;
-        
-        drawComponent(component, color);
-	}
+    const Component* hovered = nullptr;
+    const Component* selected = nullptr;
+
+    if (mode == SELECTING || mode == SELECTED) {
+        if (grid.getComponentUnderPosition(mousePos, comp) && comp->type != &WIRE)
+            hovered = comp;
+        selected = selectedComponent;
+    }
+
+    batch.setHighlights(hovered, selected);
+
+    // Components are drawn through a view that covers exactly the grid area,
+    // so anything outside of it is clipped instead of drawn over the panels
+    sf::FloatRect area = grid.getArea();
+    sf::View gridView(area);
+    gridView.setViewport(sf::FloatRect(area.left / float(SCREEN_WIDTH), area.top / float(SCREEN_HEIGHT),
+                                       area.width / float(SCREEN_WIDTH), area.height / float(SCREEN_HEIGHT)));
+
+    sf::View defaultView = window.getView();
+    window.setView(gridView);
+
+    // Draw every component with one draw call
+    sf::RenderStates states;
+    states.transform = grid.getTransform();
+    window.draw(batch, states);
 
     // If the user is in the middle of placing a component, draw a "dummy"
     // component to allow the user to visualize what they're placing.
     if (mode == PLACING_COMPONENT) {
-        GridSpot* spot;
-        if (grid.getNearestSpot(sf::Mouse::getPosition(window), spot)) {
-            placingComponent->negative = spot;
-            drawComponent(placingComponent);
+        sf::Vector2i point;
+        if (grid.getNearestPoint(mousePos, point)) {
+            placingVertices.clear();
+            batch.append(placingVertices, placingComponentType, sf::Vector2f(placingStart),
+                         sf::Vector2f(point), COMPONENT_COLOR);
+
+            states.texture = &batch.getTexture();
+            window.draw(placingVertices, states);
         }
     }
+
+    window.setView(defaultView);
 }
 
-void ApplicationManager::drawGui() {
+void ApplicationManager::drawGui(sf::RenderTarget& target) {
 	// Draw debug objects. TODO: Remove
 	if (false) {
 		// Draw grid spots
-		for (auto row : grid.getSpots()) {
+		for (const auto& row : grid.getSpots()) {
             for (GridSpot* spot : row) {
                 sf::CircleShape spotCircle(3.0f);
                 spotCircle.setFillColor(sf::Color::Red);
-                spotCircle.setPosition(float(spot->x - 3), float(spot->y - 3));
-                window.draw(spotCircle);
+                spotCircle.setPosition(grid.toScreen(spot) - sf::Vector2f(3.0f, 3.0f));
+                target.draw(spotCircle);
             }
 		}
 	}
 
     // Draw left panel items
-    drawTitlePanel();
-	drawComponentPanel();
-    drawInstructionPanel();
-    drawInfoPanel();
+    drawTitlePanel(target);
+	drawComponentPanel(target);
+    drawInstructionPanel(target);
+    drawInfoPanel(target);
 
     // Draw border around grid
-    drawRectangleHollow(
+    drawRectangleHollow(target,
         { float(GRID_LEFT_OFFSET), float(GRID_TOP_OFFSET) },
         { float(SCREEN_WIDTH - GRID_RIGHT_OFFSET), float(GRID_TOP_OFFSET) },
         { float(SCREEN_WIDTH - GRID_RIGHT_OFFSET), float(SCREEN_HEIGHT - GRID_BOTTOM_OFFSET) },
@@ -303,9 +396,9 @@ void ApplicationManager::drawGui() {
     );
 }
 
-void ApplicationManager::drawTitlePanel() {
+void ApplicationManager::drawTitlePanel(sf::RenderTarget& target) {
     // Draw panel outline
-    drawRectangleHollow(PANEL_TITLE_1, PANEL_TITLE_2, PANEL_TITLE_3, 
+    drawRectangleHollow(target, PANEL_TITLE_1, PANEL_TITLE_2, PANEL_TITLE_3, 
                         PANEL_TITLE_4, BORDER_COLOR);
 
     // Draw text
@@ -317,10 +410,10 @@ void ApplicationManager::drawTitlePanel() {
     title.setPosition(float(GUI_X_PADDING + 15), float(GUI_Y_PADDING + 15));
     title.setStyle(sf::Text::Style::Bold);
 
-    window.draw(title);
+    target.draw(title);
 }
 
-void ApplicationManager::drawComponentPanel() {
+void ApplicationManager::drawComponentPanel(sf::RenderTarget& target) {
     sf::Text text;
     std::string name;
 
@@ -335,7 +428,7 @@ void ApplicationManager::drawComponentPanel() {
                                       &VSRC };
 
     // Draw panel outline
-    drawRectangleHollow(PANEL_COMP_1, PANEL_COMP_2, PANEL_COMP_3, PANEL_COMP_4,
+    drawRectangleHollow(target, PANEL_COMP_1, PANEL_COMP_2, PANEL_COMP_3, PANEL_COMP_4,
                         BORDER_COLOR);
 
     // Draw panel title
@@ -346,7 +439,7 @@ void ApplicationManager::drawComponentPanel() {
     title.setFillColor(sf::Color::White);
 	title.setPosition(float(xPos), float(yPos));
 
-	window.draw(title);
+	target.draw(title);
 
 	yPos += 35;
 
@@ -369,22 +462,22 @@ void ApplicationManager::drawComponentPanel() {
             sf::RectangleShape rect({ 265, 20 });
             rect.setFillColor({ 225, 225, 225 });
             rect.setPosition(float(xPos - 3), float(yPos + 1));
-            window.draw(rect);
+            target.draw(rect);
         }
 
-        window.draw(text);
+        target.draw(text);
 
         yPos += 20;
     }
 }
 
-void ApplicationManager::drawInstructionPanel() {
+void ApplicationManager::drawInstructionPanel(sf::RenderTarget& target) {
     sf::Text title,
              info;
     std::string infoStr;
 
     // Draw panel outline
-    drawRectangleHollow(PANEL_INSTRUCT_1, PANEL_INSTRUCT_2, 
+    drawRectangleHollow(target, PANEL_INSTRUCT_1, PANEL_INSTRUCT_2, 
                         PANEL_INSTRUCT_3, PANEL_INSTRUCT_4, BORDER_COLOR);
 
     // Draw panel title
@@ -412,7 +505,7 @@ void ApplicationManager::drawInstructionPanel() {
     }
 
     title.setString(titleStr);
-    window.draw(title);
+    target.draw(title);
 
     // Display a basic description of the current mode
     info.setFont(DEFAULT_FONT);
@@ -422,7 +515,7 @@ void ApplicationManager::drawInstructionPanel() {
 
     // Draw different information text depending on the mode
     if (mode == PLACING || mode == PLACING_COMPONENT) {
-        infoStr = "Place components on the\ngrid.";
+        infoStr = "Place components on the\ngrid. Scroll to zoom,\nand drag with the middle\nmouse button to pan.\n\nCtrl+S saves the circuit,\nand Ctrl+O loads it.\nCtrl+E exports it as a\nSPICE netlist.";
     } else if (mode == SELECTING) {
         infoStr = "Select a component in\norder to view its info or\nchange "
                   "its properties.";
@@ -436,11 +529,21 @@ void ApplicationManager::drawInstructionPanel() {
     }
 
     info.setString(infoStr);
-    window.draw(info);
-
-    // Display error message if there was a calculation error
-    if (error) {
-        sf::Texture tex = textures.at(2);
+    target.draw(info);
+
+    // While the circuit is being solved, the values shown are out of date
+    if (solving) {
+        sf::Text status;
+        status.setFont(DEFAULT_FONT);
+        status.setCharacterSize(DEFAULT_FONT_SIZE - 3);
+        status.setFillColor(DEFAULT_COLOR);
+        status.setPosition(PANEL_INSTRUCT_4 + sf::Vector2f{ 15.0, -45.0 });
+        status.setString("Solving...");
+
+        target.draw(status);
+    } else if (error) {
+        // Display error message if there was a calculation error
+        const sf::Texture& tex = errorTexture;
         sf::Vector2f spritePos1(PANEL_INSTRUCT_4 + sf::Vector2f{ 40.0, -25.0 }),
                      spritePos2(PANEL_INSTRUCT_3 + sf::Vector2f{ -40.0, -25.0 });
         sf::Sprite error1, 
@@ -464,15 +567,15 @@ void ApplicationManager::drawInstructionPanel() {
         error1.setColor(WARNING_COLOR);
         error2.setColor(WARNING_COLOR);
 
-        window.draw(error1);
-        window.draw(error2);
-        window.draw(warning);
+        target.draw(error1);
+        target.draw(error2);
+        target.draw(warning);
     }
 }
 
-void ApplicationManager::drawInfoPanel() {
+void ApplicationManager::drawInfoPanel(sf::RenderTarget& target) {
     // Draw panel outline
-    drawRectangleHollow(PANEL_INFO_1, PANEL_INFO_2, PANEL_INFO_3, 
+    drawRectangleHollow(target, PANEL_INFO_1, PANEL_INFO_2, PANEL_INFO_3, 
                         PANEL_INFO_4, BORDER_COLOR);
 
     if (selectedComponent != nullptr && selectedComponent->type != &WIRE) {
@@ -523,9 +626,9 @@ void ApplicationManager::drawInfoPanel() {
         ampsThrough.setPosition(float(GUI_X_PADDING + 15), 
                                 float(SCREEN_HEIGHT - GUI_Y_PADDING - 110));
 
-        window.draw(title);
-        window.draw(voltageDrop);
-        window.draw(ampsThrough);
+        target.draw(title);
+        target.draw(voltageDrop);
+        target.draw(ampsThrough);
 
         // Check if the component type is a wire so the value part isn't
         // drawn unnecessarily
@@ -544,7 +647,7 @@ void ApplicationManager::drawInfoPanel() {
             value.setString(ss.str());
             value.setPosition(float(GUI_X_PADDING + 15), float(SCREEN_HEIGHT - GUI_Y_PADDING - 60));
 
-            window.draw(value);
+            target.draw(value);
         }
     } else {
         // Display simple placeholder message
@@ -555,108 +658,19 @@ void ApplicationManager::drawInfoPanel() {
         text.setFillColor(sf::Color::White);
         text.setPosition(float(GUI_X_PADDING + 30), float(SCREEN_HEIGHT - GUI_Y_PADDING - 140));
 
-        window.draw(text);
+        target.draw(text);
     }
 }
 
-void ApplicationManager::drawComponent(Component* component, sf::Color color) {
-	sf::Vector2f posSpot = component->positive->getVector();
-	sf::Vector2f negSpot = component->negative->getVector();
-	sf::CircleShape c1(5.0f),
-                    c2;
-    const ComponentType* type;
-    float length,
-          radians;
-    sf::Vector2f offset;
-
-    // Draw component endpoints
-    c1.setOrigin({ 5.0f, 5.0f });
-	c1.setPosition(posSpot);
-    c1.setFillColor(color);
-    c1.setOutlineColor({ 120, 120, 120 });
-	c1.setOutlineThickness(1.0f);
-
-    c2 = sf::CircleShape(c1);
-	c2.setPosition(negSpot);
-
-	window.draw(c1);
-	window.draw(c2);
-
-    // Draw actual component
-    type = component->type;
-
-    // Get length and angle of the component.
-    length = float(sqrt(pow(posSpot.x - negSpot.x, 2.0) + pow(posSpot.y - negSpot.y, 2.0)));
-    radians = PI + atan2(posSpot.y - negSpot.y, posSpot.x - negSpot.x);
-
-    // The rectangle objects like to be off by one pixel at all times. This
-    // vector is added to their position to correct that.
-    offset = { sin(radians), -cos(radians) };
-
-    if (type == &WIRE) {
-        sf::RectangleShape rect(sf::Vector2f(length, 2.0f));
-        rect.setFillColor(color);
-        rect.setRotation(radians * 180.0f / PI);
-        rect.setPosition(posSpot + offset);
-
-        window.draw(rect);
-    } else {
-        sf::Texture tex;
-        sf::Vector2f spritePos;
-        sf::Sprite sprite;
-        sf::RectangleShape rect1,
-                           rect2;
-
-        // Draw different textures depending on component types (with slightly
-        // different positions)
-        if (type == &RESISTOR) {
-            tex = textures.at(0);
-            spritePos = { posSpot.x - (posSpot.x - negSpot.x) / 2.0f + sin(radians) * float(tex.getSize().x) / 4.0f,
-                          posSpot.y - (posSpot.y - negSpot.y) / 2.0f - cos(radians) * float(tex.getSize().y) / 2.0f };
-        } else if (type == &VSRC) {
-            tex = textures.at(1);
-            spritePos = { posSpot.x - (posSpot.x - negSpot.x) / 2.0f + sin(radians) * float(tex.getSize().x) / 2.0f,
-                          posSpot.y - (posSpot.y - negSpot.y) / 2.0f - cos(radians) * float(tex.getSize().y) / 2.0f };
-        }
-
-        rect1 = sf::RectangleShape({ 0.5f * (length - float(tex.getSize().x)), 2.0f });
-        rect1.setFillColor(color);
-        rect1.setRotation(radians * 180.0f / PI);
-        rect1.setPosition(posSpot + offset);
-
-        rect2 = sf::RectangleShape(rect1);
-        rect2.setRotation((radians + PI) * 180.0f / PI);
-        rect2.setPosition(negSpot + -offset);
-
-        sprite.setOrigin({ float(tex.getSize().x) / 2.0f, 0.0f });
-        sprite.setTexture(tex);
-        sprite.setPosition(spritePos);
-        sprite.setRotation(radians * (180.0f / PI));
-        sprite.setColor(color);
-
-        window.draw(rect1);
-        window.draw(rect2);
-        window.draw(sprite);
-    }
-}
+void ApplicationManager::drawRectangleHollow(sf::RenderTarget& target, sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3, sf::Vector2f p4, sf::Color color) {
+    // Draw the four sides as one line strip, ending back at the first point
+    const sf::Vertex vertices[5] = { { p1, color },
+                                     { p2, color },
+                                     { p3, color },
+                                     { p4, color },
+                                     { p1, color } };
 
-void ApplicationManager::drawRectangleHollow(sf::Vector2f p1, sf::Vector2f p2, sf::Vector2f p3, sf::Vector2f p4, sf::Color color) {
-    drawLine(p1, p2, color);
-    drawLine(p2, p3, color);
-    drawLine(p3, p4, color);
-    drawLine(p4, p1, color);
-}
-
-void ApplicationManager::drawLine(sf::Vector2f p1, sf::Vector2f p2, sf::Color color) {
-    // Convert vectors to vertices
-    sf::Vertex v1(p1),
-               v2(p2);
-
-    v1.color = color;
-    v2.color = color;
-
-    const sf::Vertex vertices[2] = { v1, v2 };
-    window.draw(vertices, 2, sf::PrimitiveType::Lines);
+    target.draw(vertices, 5, sf::PrimitiveType::LineStrip);
 }
 
 ////////////////////
@@ -696,14 +710,92 @@ void ApplicationManager::setSelectedComponentValue(std::string input) {
     }
 }
 
-void ApplicationManager::recalculate() {
-    // Attempt to calculate all voltage and current values for all components
-    // on the grid. Catch and exception and, no matter the exception, display
-    // a warning to the user.
+void ApplicationManager::saveCircuit() {
+    try {
+        BinaryCircuitFile::write(CIRCUIT_FILE, grid.getComponents());
+    } catch (const std::exception& e) {
+        std::cerr << "Error saving circuit: " << e.what() << std::endl;
+    }
+}
+
+void ApplicationManager::exportCircuit() {
+    try {
+        SpiceFile::save(SPICE_FILE, grid.getComponents());
+    } catch (const std::exception& e) {
+        std::cerr << "Error exporting circuit: " << e.what() << std::endl;
+    }
+}
+
+void ApplicationManager::clearGrid() {
+    grid.clearComponents();
+
+    // The selected component was deleted with the rest
+    selectedComponent = nullptr;
+    if (mode == SELECTED || mode == TYPING)
+        mode = SELECTING;
+    input = "";
+}
+
+void ApplicationManager::loadCircuit() {
+    // Open the file before clearing the grid, so a bad file leaves the
+    // current circuit alone
+    std::unique_ptr<BinaryCircuitFile> file;
+
     try {
-        Calculator::calculate(grid.getSpots(), grid.getComponents());
-        error = false;
-    } catch (...) {
-        error = true;
+        file.reset(new BinaryCircuitFile(CIRCUIT_FILE));
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading circuit: " << e.what() << std::endl;
+        return;
     }
+
+    clearGrid();
+    grid.reserve(file->getComponentCount(), file->getSpotCount());
+
+    for (std::size_t i = 0; i < file->getComponentCount(); i++) {
+        const ComponentRecord& record = file->getRecord(i);
+        Component* component = new Component(file->getType(i));
+        component->value = record.value;
+
+        grid.addComponent(component, { record.x1, record.y1 }, { record.x2, record.y2 });
+    }
+
+    componentsChanged = true;
+    recalculate();
+}
+
+void ApplicationManager::recalculate() {
+    // Solve a copy of the circuit in the background. Any solve still running
+    // for an older version of the circuit will be ignored.
+    solveVersion = worker.submit(grid.getComponents());
+    solving = true;
+
+    // Show that the values are being calculated
+    guiChanged = true;
+    sceneChanged = true;
+}
+
+void ApplicationManager::collectSolveResult() {
+    SolveResult result;
+
+    if (!solving || !worker.takeResult(result) || result.version != solveVersion)
+        return;
+
+    // The circuit has not been edited since this version was submitted, so
+    // the results are in the same order as the grid's components
+    error = result.error;
+    if (!error) {
+        const std::vector<Component*>& components = grid.getComponents();
+
+        for (std::size_t i = 0; i < components.size(); i++) {
+            components[i]->voltageDrop = result.voltages[i];
+            components[i]->currentThrough = result.currents[i];
+        }
+    }
+
+    solving = false;
+
+    // The selected component's values and the error message may have
+    // changed
+    guiChanged = true;
+    sceneChanged = true;
 }
\ No newline at end of file
@@ -7,7 +7,7 @@
                         coordinating the grid of components.
     Due Date:           4/25/2018
     Date Created:       3/16/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
@@ -19,9 +19,11 @@
                                  // Keyboard, Vector2i/f, Color, CircleShape,
                                  // RectangleShape, Text, Sprite, Vertex, and
                                  // associated methods.
+#include "ComponentBatch.h"
 #include "Grid.h"
 #include "Component.h"
 #include "Config.h"
+#include "SolverWorker.h"
 
 /**
     This enum tracks the current state of the application. There
@@ -59,16 +61,41 @@ class ApplicationManager {
         // of a component
         std::string input = "";
 
-        // A vector that holds component textures used for the rendering of the
-        // component on the GUI. The textures are initialized in the 
-        // constructor.
-		std::vector<sf::Texture> textures;
+        // The texture of the error icon shown when the circuit is invalid.
+        // Initialized in the constructor.
+        sf::Texture errorTexture;
+
+        // Draws every component on the grid with one draw call. Its vertices
+        // are rebuilt only when componentsChanged is set.
+        ComponentBatch batch;
+        bool componentsChanged = true;
+
+        // Whether anything shown in the window has changed since it was last
+        // drawn. Unless CONTINUOUS_RENDERING is set, the window is only
+        // redrawn when this is set.
+        bool sceneChanged = true;
+
+        // The GUI panels and the border around the grid, drawn once and then
+        // copied to the window every frame. guiChanged is set whenever
+        // anything shown in them changes.
+        sf::RenderTexture guiLayer;
+        bool guiChanged = true;
+
+        // The vertices of the dummy component drawn while the user is
+        // mid-place. Kept so its memory is reused every frame.
+        sf::VertexArray placingVertices = sf::VertexArray(sf::Triangles);
 
         // The type that the user currently has selected.
 		const ComponentType* placingComponentType;
 
+        // The lattice point the user placed the first end of a component at.
         // Used to draw a dummy component while the user is mid-place.
-		Component* placingComponent;
+        sf::Vector2i placingStart;
+
+        // Whether the user is dragging the grid with the middle mouse button,
+        // and the last mouse position of the drag
+        bool panning = false;
+        sf::Vector2i panPosition;
 
         // The component that the user has selected.
         Component* selectedComponent;
@@ -76,6 +103,20 @@ class ApplicationManager {
         // Grid object instance.
 		Grid grid;
 
+        // Solves copies of the circuit on the grid in the background. It
+        // keeps the factored system between solves, so edits that only
+        // change a component's value are fast.
+        SolverWorker worker;
+
+        // The version of the last circuit submitted to the worker, and
+        // whether its result has not been shown yet
+        long long solveVersion = 0;
+        bool solving = false;
+
+        // How long update() waits for a running solve before checking for
+        // events again, when rendering on demand
+        static const int SOLVE_WAIT_MILLISECONDS = 16;
+
         // Instance of an SFML window object, which is what is displayed to the
         // user.
 		sf::RenderWindow window;
@@ -106,7 +147,11 @@ class ApplicationManager {
 
         /**
             Description:   Redraws the window and polls for available events 
-                           (eg: Mouse clicks, keyboard input, etc).
+                           (eg: Mouse clicks, keyboard input, etc). Unless
+                           CONTINUOUS_RENDERING is set, blocks until an event
+                           arrives (or a running solve finishes) if nothing
+                           has changed, and only redraws the window if
+                           something has.
             Returns:       void
             Precondition:  This object exists.
             Postcondition: The application and the user's display will have
@@ -175,6 +220,42 @@ class ApplicationManager {
         */
 		void handleMousePressed(sf::Event::MouseButtonEvent);
 
+        /**
+            Description:   Handles all incoming mouse button released events.
+                           Ends panning the grid.
+            Returns:       void
+            Precondition:  This object exists. The provided event has been
+                           correctly polled from SFML's input buffer.
+            Postcondition: The application will have been updated depending on
+                           previous state and current input. The argument will
+                           not be modified.
+        */
+        void handleMouseReleased(sf::Event::MouseButtonEvent);
+
+        /**
+            Description:   Handles all incoming mouse moved events. Pans the
+                           grid while the middle mouse button is held.
+            Returns:       void
+            Precondition:  This object exists. The provided event has been
+                           correctly polled from SFML's input buffer.
+            Postcondition: The application will have been updated depending on
+                           previous state and current input. The argument will
+                           not be modified.
+        */
+        void handleMouseMoved(sf::Event::MouseMoveEvent);
+
+        /**
+            Description:   Handles all incoming mouse wheel events. Zooms the
+                           grid in or out around the mouse cursor.
+            Returns:       void
+            Precondition:  This object exists. The provided event has been
+                           correctly polled from SFML's input buffer.
+            Postcondition: The application will have been updated depending on
+                           previous state and current input. The argument will
+                           not be modified.
+        */
+        void handleMouseScrolled(sf::Event::MouseWheelScrollEvent);
+
         /**
             Description:   Handles all incoming resized events. Triggered
                            whenever the user resizes the application.
@@ -209,27 +290,26 @@ class ApplicationManager {
         /**
             Description:   Drawing the application GUI. This consists of the
                            left sidebar of information, as well as the border
-                           around the main grid.
+                           around the main grid. Only called when guiChanged
+                           is set; the result is kept in guiLayer.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified.
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified.
         */
-		void drawGui();
+		void drawGui(sf::RenderTarget&);
 
         /**
             Description:   Draws the title panel, the topmost panel in the left
                            sidebar. Contains the title of the application.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified.
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified.
         */
-        void drawTitlePanel();
+        void drawTitlePanel(sf::RenderTarget&);
 
         /**
             Description:   Draws the component panel below the title bar.
@@ -237,12 +317,11 @@ class ApplicationManager {
                            select when placing components.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified.
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified.
         */
-		void drawComponentPanel();
+		void drawComponentPanel(sf::RenderTarget&);
 
         /**
             Description:   Draws the instruction panel below the component
@@ -250,12 +329,11 @@ class ApplicationManager {
                            provides a brief description of what they can do.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified.
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified.
         */
-        void drawInstructionPanel();
+        void drawInstructionPanel(sf::RenderTarget&);
 
         /**
             Description:   Draws the information panel below the instruction
@@ -264,58 +342,26 @@ class ApplicationManager {
                            and the component value, if it is not a wire.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified.
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified.
         */
-        void drawInfoPanel();
-
-        /**
-            Description:   Draws the specified component at its two points on
-                           on the grid. The second argument determines the
-                           component color, defaults to COMPONENT_COLOR.
-            Returns:       void
-            Precondition:  This object exists, and the component passed in has
-                           been correctly initialized and its spots have been
-                           set.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified. The arguments
-                           will not be modified.
-        */
-		void drawComponent(Component*, sf::Color = COMPONENT_COLOR);
+        void drawInfoPanel(sf::RenderTarget&);
 
         /**
             Description:   Draws a hollow rectangle at the specified positions
                            in the specified color. Draws the lines in the order
                            they were provided: v1 to v2, v2 to v3, v3 to v4, 
-                           and v4 to v1.
-            Returns:       void
-            Precondition:  This object exists, and all vectors have coordinates
-                           that are within the bounds of the window.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified. The arguments
-                           will not be modified.
-        */
-        void drawRectangleHollow(sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3, sf::Vector2f v4, sf::Color);
-
-        /**
-            Description:   Draws a line from the first vector to the second 
-                           with the specified color.
+                           and v4 to v1, as a single line strip.
             Returns:       void
             Precondition:  This object exists, and all vectors have coordinates
                            that are within the bounds of the window.
-            Postcondition: The user's display will have been updated depending
-                           on previous state and current input. The state of
-                           this object, aside from the current state of the
-                           window, will not have been modified. The arguments
+            Postcondition: The target will have been updated depending on
+                           previous state and current input. The state of this
+                           object will not have been modified. The arguments
                            will not be modified.
         */
-        void drawLine(sf::Vector2f, sf::Vector2f, sf::Color);
+        void drawRectangleHollow(sf::RenderTarget&, sf::Vector2f v1, sf::Vector2f v2, sf::Vector2f v3, sf::Vector2f v4, sf::Color);
 
 
 		////////////////////
@@ -336,15 +382,72 @@ class ApplicationManager {
         void setSelectedComponentValue(std::string);
 
         /**
-            Description:   Recalculates all component values. Catches any
-                           errors that are thrown when calculating the circuit,
-                           and enables the application's error state if this
-                           occurs.
+            Description:   Saves the circuit on the grid to CIRCUIT_FILE, as a
+                           binary circuit file. Errors are printed to the
+                           console.
             Returns:       void
             Precondition:  This object exists.
-            Postcondition: The application and the user's display will have
-                           been updated depending on previous state and current
-                           input.
+            Postcondition: The file will have been written. The application
+                           will not be modified.
+        */
+        void saveCircuit();
+
+        /**
+            Description:   Exports the circuit on the grid to SPICE_FILE, as a
+                           SPICE netlist. Errors are printed to the console.
+            Returns:       void
+            Precondition:  This object exists.
+            Postcondition: The file will have been written. The application
+                           will not be modified.
+        */
+        void exportCircuit();
+
+        /**
+            Description:   Deletes every component on the grid, and deselects
+                           the selected component.
+            Returns:       void
+            Precondition:  This object exists.
+            Postcondition: The grid will be empty, no component will be
+                           selected, and the application will not be in
+                           SELECTED or TYPING mode. The circuit is not
+                           recalculated.
+        */
+        void clearGrid();
+
+        /**
+            Description:   Replaces the circuit on the grid with the one saved
+                           in CIRCUIT_FILE. Errors are printed to the console.
+            Returns:       void
+            Precondition:  This object exists.
+            Postcondition: If the file could be read, the grid will hold its
+                           components, no component will be selected, and
+                           the circuit will be recalculated. Else, the grid
+                           is not modified.
+        */
+        void loadCircuit();
+
+        /**
+            Description:   Starts recalculating all component values in the
+                           background. The values are shown once
+                           collectSolveResult() finds the result.
+            Returns:       void
+            Precondition:  This object exists.
+            Postcondition: A copy of the circuit will have been submitted to
+                           the worker, and the application will show that it
+                           is solving.
         */
         void recalculate();
+
+        /**
+            Description:   Applies the result of the last circuit submitted by
+                           recalculate(), if it has finished. Enables the
+                           application's error state if solving it threw an
+                           error. Results of older circuits are ignored.
+            Returns:       void
+            Precondition:  This object exists.
+            Postcondition: If the result was ready, the components will have
+                           their new voltages and currents, and the
+                           application will no longer show that it is solving.
+        */
+        void collectSolveResult();
 };
\ No newline at end of file
@@ -0,0 +1,278 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         BinaryCircuitFile.cpp
+    File Description:   Implements the BinaryCircuitFile class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <cstring>        // memcmp, memcpy
+#include <fstream>        // ifstream, ofstream classes
+#include <stdexcept>      // runtime_error
+#include <unordered_set>  // unordered_set class
+#include "BinaryCircuitFile.h"
+#include "GridSpot.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[8] = { 'C', 'S', 'I', 'M', 'C', 'I', 'R', 'C' };
+    const std::uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+    /**
+        The fixed part at the start of a binary circuit file.
+    */
+    struct Header {
+        char magic[8];
+        std::uint32_t version,
+                      byteOrder,
+                      recordSize,
+                      reserved;
+        std::uint64_t componentCount,
+                      spotCount,
+                      stringsSize;
+    };
+
+    static_assert(sizeof(Header) == 48, "The header must match the file layout");
+    static_assert(sizeof(ComponentRecord) == 32, "A record must match the file layout");
+
+    // The component types, indexed by their id in a record
+    const ComponentType* const TYPES[] = { &WIRE, &RESISTOR, &VSRC };
+    const std::size_t TYPE_COUNT = sizeof(TYPES) / sizeof(TYPES[0]);
+}
+
+BinaryCircuitFile::BinaryCircuitFile(const std::string& path) {
+    // Map the whole file, read only
+#ifdef _WIN32
+    file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                       FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        file = nullptr;
+        throw std::runtime_error("Unable to open " + path);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize)) {
+        close();
+        throw std::runtime_error("Unable to read " + path);
+    }
+    size = std::size_t(fileSize.QuadPart);
+
+    if (size >= sizeof(Header)) {
+        mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (mapping != nullptr)
+            data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+
+        if (data == nullptr) {
+            close();
+            throw std::runtime_error("Unable to map " + path);
+        }
+    }
+#else
+    int descriptor = open(path.c_str(), O_RDONLY);
+    if (descriptor < 0)
+        throw std::runtime_error("Unable to open " + path);
+
+    struct stat status;
+    if (fstat(descriptor, &status) != 0) {
+        ::close(descriptor);
+        throw std::runtime_error("Unable to read " + path);
+    }
+    size = std::size_t(status.st_size);
+
+    if (size >= sizeof(Header)) {
+        void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        if (mapped != MAP_FAILED)
+            data = static_cast<const char*>(mapped);
+    }
+
+    // The mapping stays valid after the file is closed
+    ::close(descriptor);
+
+    if (size >= sizeof(Header) && data == nullptr)
+        throw std::runtime_error("Unable to map " + path);
+#endif
+
+    // Check the header. The mapping is page aligned, and the header is a
+    // multiple of 8 bytes long, so the records can be used in place.
+    if (size < sizeof(Header)) {
+        close();
+        throw std::runtime_error(path + " is not a binary circuit file");
+    }
+
+    const Header* header = reinterpret_cast<const Header*>(data);
+    std::string error;
+
+    if (memcmp(header->magic, MAGIC, sizeof(MAGIC)) != 0)
+        error = " is not a binary circuit file";
+    else if (header->version > VERSION)
+        error = " was written by a newer version";
+    else if (header->byteOrder != BYTE_ORDER_MARK)
+        error = " was written on a machine with a different byte order";
+    else if (header->recordSize != sizeof(ComponentRecord))
+        error = " has records of an unknown size";
+    else if (header->componentCount > (size - sizeof(Header)) / sizeof(ComponentRecord) ||
+             header->stringsSize != size - sizeof(Header) - header->componentCount * sizeof(ComponentRecord))
+        error = " is truncated or has trailing data";
+    else if (header->stringsSize != 0 && data[size - 1] != '\0')
+        error = " has an unterminated string table";
+    else if (header->spotCount > 2 * header->componentCount)
+        error = " has more lattice points than its components can use";
+
+    if (error.empty()) {
+        componentCount = std::size_t(header->componentCount);
+        spotCount = std::size_t(header->spotCount);
+        records = reinterpret_cast<const ComponentRecord*>(data + sizeof(Header));
+        strings = data + sizeof(Header) + componentCount * sizeof(ComponentRecord);
+        stringsSize = std::size_t(header->stringsSize);
+
+        // The records are used without further checks, so check every type
+        // and name once
+        for (std::size_t i = 0; i < componentCount && error.empty(); i++) {
+            if (records[i].type >= TYPE_COUNT)
+                error = ": component " + std::to_string(i) + " has an unknown type";
+            else if (records[i].name != ComponentRecord::NO_NAME && records[i].name >= stringsSize)
+                error = ": component " + std::to_string(i) + " has an invalid name";
+        }
+    }
+
+    if (!error.empty()) {
+        close();
+        throw std::runtime_error(path + error);
+    }
+}
+
+BinaryCircuitFile::~BinaryCircuitFile() {
+    close();
+}
+
+void BinaryCircuitFile::close() {
+#ifdef _WIN32
+    if (data != nullptr)
+        UnmapViewOfFile(data);
+    if (mapping != nullptr)
+        CloseHandle(mapping);
+    if (file != nullptr)
+        CloseHandle(file);
+
+    mapping = nullptr;
+    file = nullptr;
+#else
+    if (data != nullptr)
+        munmap(const_cast<char*>(data), size);
+#endif
+
+    data = nullptr;
+    records = nullptr;
+    strings = nullptr;
+    componentCount = 0;
+}
+
+std::size_t BinaryCircuitFile::getComponentCount() const {
+    return componentCount;
+}
+
+std::size_t BinaryCircuitFile::getSpotCount() const {
+    return spotCount;
+}
+
+const ComponentRecord& BinaryCircuitFile::getRecord(std::size_t index) const {
+    return records[index];
+}
+
+const ComponentType* BinaryCircuitFile::getType(std::size_t index) const {
+    return TYPES[records[index].type];
+}
+
+const char* BinaryCircuitFile::getName(std::size_t index) const {
+    std::uint32_t name = records[index].name;
+    return name == ComponentRecord::NO_NAME ? "" : strings + name;
+}
+
+void BinaryCircuitFile::read(Circuit& circuit) const {
+    circuit.reserve(componentCount, spotCount);
+
+    for (std::size_t i = 0; i < componentCount; i++) {
+        const ComponentRecord& record = records[i];
+
+        circuit.addComponent(getName(i), TYPES[record.type],
+                             record.x1, record.y1, record.x2, record.y2, record.value);
+    }
+}
+
+bool BinaryCircuitFile::isBinary(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+
+    return in.read(magic, sizeof(magic)) && memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+void BinaryCircuitFile::write(const std::string& path, const std::vector<Component*>& components,
+                              const std::vector<std::string>& names) {
+    std::vector<ComponentRecord> output(components.size());
+    std::string table;
+    std::unordered_set<const GridSpot*> spots;
+
+    spots.reserve(components.size());
+
+    for (std::size_t i = 0; i < components.size(); i++) {
+        const Component* component = components[i];
+        ComponentRecord& record = output[i];
+
+        std::size_t type = 0;
+        while (type < TYPE_COUNT && TYPES[type] != component->type)
+            type++;
+
+        if (type == TYPE_COUNT)
+            throw std::runtime_error("Cannot save a component of type " + component->type->getName());
+
+        record.type = std::uint8_t(type);
+        record.reserved[0] = record.reserved[1] = record.reserved[2] = 0;
+        record.x1 = component->positive->x;
+        record.y1 = component->positive->y;
+        record.x2 = component->negative->x;
+        record.y2 = component->negative->y;
+        record.value = component->value;
+        record.name = ComponentRecord::NO_NAME;
+
+        if (i < names.size() && !names[i].empty()) {
+            if (table.size() >= ComponentRecord::NO_NAME)
+                throw std::runtime_error("Too many component names to save");
+
+            record.name = std::uint32_t(table.size());
+            table += names[i];
+            table += '\0';
+        }
+
+        spots.insert(component->positive);
+        spots.insert(component->negative);
+    }
+
+    Header header;
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.recordSize = sizeof(ComponentRecord);
+    header.reserved = 0;
+    header.componentCount = output.size();
+    header.spotCount = spots.size();
+    header.stringsSize = table.size();
+
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    if (!out)
+        throw std::runtime_error("Unable to open " + path);
+
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(output.data()), std::streamsize(output.size() * sizeof(ComponentRecord)));
+    out.write(table.data(), std::streamsize(table.size()));
+
+    if (!out)
+        throw std::runtime_error("Unable to write " + path);
+}
\ No newline at end of file
@@ -0,0 +1,192 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         BinaryCircuitFile.h
+    File Description:   Declares the ComponentRecord struct and the
+                        BinaryCircuitFile class, which reads and writes
+                        circuits in a compact binary format. A file is laid
+                        out as:
+
+                            header        48 bytes (see below)
+                            records       one 32 byte ComponentRecord per
+                                          component
+                            string table  the component names, each ending
+                                          in a NUL byte
+
+                        The header holds the magic "CSIMCIRC", the format
+                        version, the value 0x01020304 written in the byte
+                        order of the machine that saved the file, the size of
+                        a record, and the number of components, the number of
+                        distinct lattice points and the size of the string
+                        table as 64 bit counts. A file is opened by mapping it
+                        into memory; the records are read in place rather
+                        than parsed.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstddef>         // size_t
+#include <cstdint>         // fixed width integer types
+#include <string>          // string class
+#include <vector>          // vector class
+#include "Circuit.h"
+#include "Component.h"
+#include "ComponentTypes.h"
+
+/**
+    One component, as stored in a binary circuit file.
+*/
+struct ComponentRecord {
+    // 0 for a wire, 1 for a resistor, 2 for a voltage source
+    std::uint8_t type;
+    std::uint8_t reserved[3];
+
+    // The positive and negative lattice points
+    std::int32_t x1,
+                 y1,
+                 x2,
+                 y2;
+
+    // The offset of the name in the string table, or NO_NAME
+    std::uint32_t name;
+
+    double value;
+
+    static const std::uint32_t NO_NAME = 0xFFFFFFFF;
+};
+
+class BinaryCircuitFile {
+    private:
+        // The newest version of the format that can be read
+        static const std::uint32_t VERSION = 1;
+
+        // The mapped file
+        const char* data = nullptr;
+        std::size_t size = 0;
+
+#ifdef _WIN32
+        void* file = nullptr;
+        void* mapping = nullptr;
+#endif
+
+        // Where the parts of the file start, and how large they are
+        const ComponentRecord* records = nullptr;
+        std::size_t componentCount = 0,
+                    spotCount = 0;
+        const char* strings = nullptr;
+        std::size_t stringsSize = 0;
+
+        /**
+            Description:   Unmaps the file.
+            Return:        void
+            Precondition:  None
+            Postcondition: The file will no longer be mapped.
+        */
+        void close();
+
+    public:
+        /**
+            Description:   Maps the file at the provided path into memory and
+                           checks that it is a valid binary circuit file.
+            Return:        None
+            Precondition:  None
+            Postcondition: Throws a runtime_error if the file cannot be
+                           opened, was written by a newer version or on a
+                           machine of a different byte order, or is not
+                           valid.
+        */
+        explicit BinaryCircuitFile(const std::string&);
+
+        // The object owns the mapping, so it cannot be copied
+        BinaryCircuitFile(const BinaryCircuitFile&) = delete;
+        BinaryCircuitFile& operator =(const BinaryCircuitFile&) = delete;
+
+        /**
+            Description:   Unmaps the file.
+            Return:        None
+            Precondition:  This object exists.
+            Postcondition: Records and names returned by this object are no
+                           longer valid.
+        */
+        ~BinaryCircuitFile();
+
+        /**
+            Description:   Returns the number of components in the file.
+            Return:        size_t
+            Precondition:  This object exists.
+            Postcondition: The count is returned. This object will not be
+                           modified.
+        */
+        std::size_t getComponentCount() const;
+
+        /**
+            Description:   Returns the number of distinct lattice points the
+                           components are connected to.
+            Return:        size_t
+            Precondition:  This object exists.
+            Postcondition: The count is returned. This object will not be
+                           modified.
+        */
+        std::size_t getSpotCount() const;
+
+        /**
+            Description:   Returns the record of the component at an index.
+            Return:        ComponentRecord
+            Precondition:  The index is less than getComponentCount().
+            Postcondition: The record is returned without being copied. This
+                           object will not be modified.
+        */
+        const ComponentRecord& getRecord(std::size_t) const;
+
+        /**
+            Description:   Returns the type of the component at an index.
+            Return:        ComponentType*
+            Precondition:  The index is less than getComponentCount().
+            Postcondition: The type is returned. This object will not be
+                           modified.
+        */
+        const ComponentType* getType(std::size_t) const;
+
+        /**
+            Description:   Returns the name of the component at an index.
+            Return:        const char*
+            Precondition:  The index is less than getComponentCount().
+            Postcondition: The name is returned, or an empty string if the
+                           component has none. This object will not be
+                           modified.
+        */
+        const char* getName(std::size_t) const;
+
+        /**
+            Description:   Adds every component in the file to the circuit.
+            Return:        void
+            Precondition:  The circuit has been initialized.
+            Postcondition: The components will have been added in the order
+                           they are stored. The circuit's indices are sized
+                           once, up front. This object will not be modified.
+        */
+        void read(Circuit&) const;
+
+        /**
+            Description:   Returns whether the file at the provided path
+                           starts with the binary circuit file magic.
+            Return:        bool
+            Precondition:  None
+            Postcondition: Returns false if the file cannot be opened.
+        */
+        static bool isBinary(const std::string&);
+
+        /**
+            Description:   Writes components to a binary circuit file. The
+                           names are optional; if given, there is one per
+                           component.
+            Return:        void
+            Precondition:  Every component is connected to two spots.
+            Postcondition: The file will have been written. Throws a
+                           runtime_error if it cannot be written, or if a
+                           component's type cannot be stored.
+        */
+        static void write(const std::string&, const std::vector<Component*>&,
+                          const std::vector<std::string>& = std::vector<std::string>());
+};
\ No newline at end of file
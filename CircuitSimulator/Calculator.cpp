@@ -5,17 +5,65 @@
                         drop and current through each component.
     Due Date:           4/25/2018
     Date Created:       4/10/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
-#include <armadillo>      // Lightweight linear algebra library
+#include <algorithm>      // min_element, max
 #include <stdexcept>      // runtime_error
+#include <unordered_map>  // unordered_map class
 #include "Calculator.h"
+#include "DisjointSet.h"
+#include "Profiler.h"
+#include "SparseMatrix.h"
+#include "SparseLU.h"
+
+bool Calculator::calculate(const spot_vec& spots, const std::vector<Component*>& components) {
+    PROFILE_SCOPE("calculate");
 
-bool Calculator::calculate(spot_vec spots, std::vector<Component*> components) {
-    bool isCompleteCircuit = true;
     std::vector<GridSpot*> populatedSpots;
 
+    // If the circuit is not complete, or the grid is completely empty,
+    // set each component voltage and current to zero and return false.
+    if (!getPopulatedSpots(spots, populatedSpots)) {
+        clearComponentValues(components);
+        return false;
+    }
+
+    NodalSystem system = buildSystem(populatedSpots);
+
+    // Factor the kcl matrix and solve for the node voltages. The solve
+    // overwrites the coeff vector with the solution. If a circuit with the
+    // same topology has been solved before, the ordering and pattern of the
+    // factors are reused.
+    SparseLU lu;
+    std::vector<double> solution = system.coeff;
+
+    {
+        PROFILE_SCOPE("factorize");
+        getSymbolicCache().factorize(system.matrix, lu);
+        PROFILE_COUNT("factorNonZeros", lu.factorNonZeros());
+    }
+
+    {
+        PROFILE_SCOPE("solve");
+        lu.solve(solution);
+    }
+
+    setComponentValues(system, solution, components);
+
+    return true;
+}
+
+SymbolicCache& Calculator::getSymbolicCache() {
+    static SymbolicCache cache;
+    return cache;
+}
+
+bool Calculator::getPopulatedSpots(const spot_vec& spots, std::vector<GridSpot*>& populatedSpots) {
+    PROFILE_SCOPE("getPopulatedSpots");
+
+    bool isCompleteCircuit = true;
+
     // Only worry about spots that have components attached to them.
     // Keep track of whether or not the circuit is complete.
     // Condition for completeness:
@@ -33,479 +81,332 @@ bool Calculator::calculate(spot_vec spots, std::vector<Component*> components) {
         }
     }
 
-    // If the circuit is not complete, or the grid is completely empty,
-    // set each component voltage and current to zero and return false.
-    if (!isCompleteCircuit || populatedSpots.size() == 0) {
-        for (int i = 0; i < components.size(); i++) {
-            components[i]->currentThrough = 0.0;
-            components[i]->voltageDrop = 0.0;
-        }
-    } else {
-
-        // Get Nodes from the circuit
-        std::vector<GridNode> gridNodes = getGridNodes(populatedSpots);
-        std::vector<Node> nodes = convertGridNodesToNodes(&gridNodes);
-        std::vector<Node> reducedNodes = reduceNodes(nodes);
-
-        // Begin the process of populating a matrix to solve for the 
-        // node voltages
-
-        arma::mat kcl(nodes.size(), nodes.size());
-        arma::mat coeff(nodes.size(), 1);
-
-        kcl.fill(0.0);
-        coeff.fill(0.0);
-
-        // In order to properly perform nodal analysis, one of the nodes must
-        // be grounded. The node that gets grounded is completely arbitrary,
-        // so here it is always the first node (node 0). The only side effect
-        // is that some nodes may have negative voltage, but it is trivial to
-        // "normalize" the voltages after they are calculated.
-        const int GROUND = 0;
-
-        // There are exactly "nodes.size()" number of equations. Since some equations
-        // come from doing KCL at nodes and some come from voltage source relations,
-        // the current row of the matrix that is being populated must be tracked,
-        // especially after this initial loop has completed.
-        int row = 0;
-
-        // Every voltage source has two nodes attached to it, however only one
-        // KCL equation can be derived from these two. To avoid populating the 
-        // matrix with duplicate roww, the nodes that get considered as a 
-        // consequence of considering the current node must be tracked and
-        // excluded from the following process
-        std::vector<Node*> excludedNodes;
-
-        // Loop through the nodes and get every possible KCL equation
-        for (Node node : reducedNodes) {
-            if (node.id == GROUND) {
-                // The voltage at the ground is 0
-                kcl(row, GROUND) = 1;
-
-                // Normally, when looking at a non-GROUND node, the nodes are examined
-                // and excludedNodes is properly populated if the program runs across
-                // any voltage sources. That is done here.
-                for (auto connection : node.connections) {
-                    if (std::get<2>(connection) == Unit::VOLT) {
-                        excludedNodes.push_back(std::get<0>(connection));
-                    }
-                }
-
-                row++;
-            } else {
-                bool consider = true;
-                for (Node* excludedNode : excludedNodes) {
-                    if (excludedNode->id == node.id)
-                        consider = false;
-                }
-
-                if (consider) {
-                    for (KCLTerm term : node.getTerms(nullptr, excludedNodes)) {
-                        // The term.res (aka resistance of the resistor) corresponds to a 
-                        // particular node. By the nature of the way KCL equations are
-                        // derived, we need to keep track of the inverses of these 
-                        // resistances. The sums of the inverses of the resistances is
-                        // what the matrix will be populated with. Negative polarity 
-                        // nodes will have their inverse sum negated.
-                        kcl(row, term.pos) += 1.0 / term.res * (term.out ? -1.0 : 1.0);
-                        kcl(row, term.neg) += -1.0 / term.res * (term.out ? -1.0 : 1.0);
-                    }
-
-                    row++;
-                }
-            }
-        }
-
-        // Loop through the nodes again, this time looking specifically for voltage
-        // sources. Each voltage source provides a direct voltage relationship 
-        // between its two nodes, and they are added to the matrices here. The
-        // excluded nodes vector is re-used.
-        excludedNodes.clear();
-
-        for (Node node : reducedNodes) {
-            bool consider = true;
-            for (Node* excludedNode : excludedNodes) {
-                if (excludedNode->id == node.id)
-                    consider = false;
-            }
+    PROFILE_COUNT("spots", populatedSpots.size());
 
-            if (consider) {
-                for (auto connection : node.connections) {
-                    if (std::get<2>(connection) == Unit::VOLT) {
-                        int pos,
-                            neg;
-
-                        if (std::get<3>(connection) == Polarity::POSITIVE) {
-                            pos = node.id;
-                            neg = std::get<0>(connection)->id;
-                        } else {
-                            pos = std::get<0>(connection)->id;
-                            neg = node.id;
-                        }
-
-                        // In a direct voltage node equation, the relationship
-                        // looks something along the lines of NODE1 - NODE2 = X,
-                        // where NODE1 is the positive voltage terminal, NODE2
-                        // is the negative voltage terminal, and X is the value
-                        // of the voltage source. In a matrix, this means that
-                        // the positive node has a weight of 1, the negative node
-                        // a weight of -1, and an additional weight in the
-                        // coefficient matrix.
-                        kcl(row, pos) = 1.0;
-                        kcl(row, neg) = -1.0;
-                        coeff(row) = std::get<1>(connection);
-
-                        // Exclude the other node connected to this voltage source
-                        // to avoid duplicate matrix entries.
-                        excludedNodes.push_back(std::get<0>(connection));
-
-                        row++;
-                    }
-                }
-            }
-        }
+    return isCompleteCircuit && populatedSpots.size() != 0;
+}
 
-        // Multiply the inverse kcl matrix by the coeff matrix to get the
-        // solution voltages.
-        arma::mat solution = kcl.i() * coeff;
+NodalSystem Calculator::buildSystem(const std::vector<GridSpot*>& populatedSpots) {
+    PROFILE_SCOPE("buildSystem");
+
+    NodalSystem system;
+
+    // Get Nodes from the circuit
+    std::vector<int> spotNodeIds = getSpotNodeIds(populatedSpots);
+
+    for (int i = 0; i < int(populatedSpots.size()); i++)
+        populatedSpots[i]->node = spotNodeIds[i];
+
+    Netlist netlist = reduceNodes(buildNetlist(populatedSpots));
+
+    PROFILE_SCOPE("stamp");
+
+    // Begin the process of populating a matrix to solve for the node
+    // voltages, using modified nodal analysis. Each node only touches a
+    // handful of components, so almost every entry of the matrix is zero.
+    // Only the nonzero entries are recorded, and are compressed once every
+    // branch has been added.
+    //
+    // There is one KCL equation per node, which sums the currents leaving
+    // the node. The current through a voltage source cannot be written in
+    // terms of node voltages, so each voltage source adds its current as an
+    // extra unknown, along with an equation fixing the voltage across it.
+    //
+    // In order to properly perform nodal analysis, one of the nodes must
+    // be grounded. The node that gets grounded is completely arbitrary,
+    // so here it is always the first node (node 0). Its voltage is known to
+    // be 0, so it has neither an equation nor an unknown, and every other
+    // node's equation and voltage move down by one. Keeping it would give
+    // the matrix a column with an entry for every neighbour of ground. The
+    // only side effect is that some nodes may have negative voltage, but it
+    // is trivial to "normalize" the voltages after they are calculated.
+    const int n = netlist.nodeCount,
+              GROUND = 0;
+    int numSources = 0;
+
+    for (int branch = 0; branch < netlist.branchCount(); branch++) {
+        if (netlist.type[branch] == Unit::VOLT)
+            numSources++;
+    }
 
-        // Because our grounding point was arbitrary, some voltage may be negative.
-        // This is easily fixed by subtracting the lowest value from all solution
-        // matrix entries
-        double min = solution.min();
+    const int unknowns = n - 1 + numSources;
 
-        // Subtract min value from each element with a simple lambda function.
-        solution.for_each([min](arma::mat::elem_type& val) { val -= min; });
+    TripletMatrix kcl(unknowns, unknowns);
+    std::vector<double> coeff(unknowns, 0.0);
 
-        // Set the node voltage from the solution matrix. Because the matrices were
-        // specifically ordered to match the node ids, the values in the first 
-        // column correspond to the first node, the second column the second node,
-        // etc.
-        for (int i = 0; i < solution.n_rows; i++) {
-            nodes[i].voltage = solution.at(i, 0);
-        }
+    system.nodeCount = n;
+    system.kclRows.resize(n);
+    for (int node = 0; node < n; node++)
+        system.kclRows[node] = node == GROUND ? -1 : node - 1;
 
-        // Start the process of turning node voltage into component voltages and currents.
-        // On first pass, the current and voltage of every resistor is calculated.
-        for (Component* component : components) {
-            if (component->type == &RESISTOR) {
-                std::pair<GridNode, GridNode> compGridNodes = getGridNodesFromComponent(gridNodes, component);
-                std::pair<Node, Node> compNodes;
-
-                for (Node tNode : nodes) {
-                    if (tNode.id == compGridNodes.first.id)
-                        compNodes.first = tNode;
-                    else if (tNode.id == compGridNodes.second.id)
-                        compNodes.second = tNode;
-                }
-
-                // compNodes.first will always be the positive node, and 
-                // compNodes.second the negative
-                double voltage = compNodes.first.voltage - compNodes.second.voltage;
-                double current = voltage / component->value;
-
-                component->voltageDrop = voltage;
-                component->currentThrough = current;
-            }
-        }
+    const std::vector<int>& rows = system.kclRows;
+    int source = n - 1;
 
-        // The voltage sources are handled second, as, in order to find the current through
-        // them, the current through all connected resistors must be known.
-        for (Component* component : components) {
-            if (component->type == &VSRC) {
-                // Voltage drop across a vsrc is just its value
-                component->voltageDrop = component->value;
+    for (int branch = 0; branch < netlist.branchCount(); branch++) {
+        int pos = rows[netlist.pos[branch]],
+            neg = rows[netlist.neg[branch]];
 
-                std::vector<Component*> resistors = getVoltageInputs(component);
+        if (netlist.type[branch] == Unit::OHM) {
+            // A resistor's current leaving its positive node is
+            // (posNodeVoltage - negNodeVoltage) / resistorValue, and the same
+            // current enters its negative node. Terms of the ground node's
+            // voltage are 0, and are left out.
+            double g = 1.0 / netlist.value[branch];
 
-                double currentSum = 0;
+            if (pos != -1) {
+                kcl.add(pos, pos, g);
+                if (neg != -1)
+                    kcl.add(pos, neg, -g);
+            }
 
-                // Sum up current inputs into the voltage source
-                for (Component* resistor : resistors)
-                    currentSum += resistor->currentThrough;
+            if (neg != -1) {
+                kcl.add(neg, neg, g);
+                if (pos != -1)
+                    kcl.add(neg, pos, -g);
+            }
+        } else {
+            // The source's current leaves its positive node and enters its
+            // negative node. Its own equation looks something along the lines
+            // of NODE1 - NODE2 = X, where NODE1 is the positive voltage
+            // terminal, NODE2 is the negative voltage terminal, and X is the
+            // value of the voltage source.
+            if (pos != -1) {
+                kcl.add(pos, source, 1.0);
+                kcl.add(source, pos, 1.0);
+            }
 
-                component->currentThrough = currentSum;
+            if (neg != -1) {
+                kcl.add(neg, source, -1.0);
+                kcl.add(source, neg, -1.0);
             }
+
+            coeff[source] = netlist.value[branch];
+            system.sourceRows[std::make_pair(netlist.pos[branch], netlist.neg[branch])] = source;
+
+            source++;
         }
     }
 
-    return isCompleteCircuit && populatedSpots.size() != 0;
+    system.matrix = kcl.compress();
+    system.coeff = coeff;
+
+    PROFILE_COUNT("unknowns", system.matrix.rows);
+    PROFILE_COUNT("nonZeros", system.matrix.nonZeros());
+
+    return system;
 }
 
-std::vector<GridNode> Calculator::getGridNodes(std::vector<GridSpot*> spots) {
-    // Holds all circuit nodes. A node is a section of the circuit that
-    // shares a common voltage. In other words, the node at a point is
-    // everything connected to that point via a wire.
-    std::vector<GridNode> nodes;
-
-    std::vector<GridSpot*>::iterator it = spots.begin();
-
-    // Loop through populated spots and assign them to a Node.
-    while (it != spots.end()) {
-        bool seen = false;
-
-        // Make sure this specific spot is not a part of any
-        // other nodes. If it is, remove it from populatedSpots
-        // and move to the next spot.
-        if (nodes.size() > 0) {
-            for (int i = 0; i < nodes.size(); i++) {
-                for (int j = 0; j < nodes[i].spots.size(); j++) {
-                    if (nodes[i].spots[j] == *it) {
-                        seen = true;
-
-                        // Grab next spot and set it as the iterator.
-                        it = spots.erase(it);
-                    }
-                }
-            }
+void Calculator::setComponentValues(const NodalSystem& system, std::vector<double> solution, const std::vector<Component*>& components) {
+    PROFILE_SCOPE("setComponentValues");
+
+    // The unknowns after the node voltages are the currents through the
+    // voltage sources. Each is the current flowing from the source's
+    // positive node into the source, so the current the source supplies to
+    // the rest of the circuit is its negative.
+    for (Component* component : components) {
+        if (component->type == &VSRC) {
+            int row = system.sourceRows.at(std::make_pair(component->positive->node,
+                                                          component->negative->node));
+
+            // Voltage drop across a vsrc is just its value
+            component->voltageDrop = component->value;
+            component->currentThrough = -solution[row];
         }
+    }
+
+    // Only the node voltages are needed from here on. The ground node's
+    // voltage is 0.
+    std::vector<double> voltages(system.nodeCount, 0.0);
 
-        if (!seen) {
-            GridNode node;
-            node.spots.push_back(*it);
+    for (int node = 0; node < system.nodeCount; node++) {
+        if (system.kclRows[node] != -1)
+            voltages[node] = solution[system.kclRows[node]];
+    }
 
-            // Get Node from circuit recursively
-            getGridNodeFromSpot(*it, node);
+    // Because our grounding point was arbitrary, some voltage may be negative.
+    // This is easily fixed by subtracting the lowest value from all node
+    // voltages
+    double min = *std::min_element(voltages.begin(), voltages.end());
 
-            nodes.push_back(node);
-            ++it;
+    for (double& val : voltages)
+        val -= min;
+
+    // Turn the node voltages into resistor voltages and currents
+    for (Component* component : components) {
+        if (component->type == &RESISTOR) {
+            double voltage = voltages[component->positive->node] -
+                             voltages[component->negative->node];
+            double current = voltage / component->value;
+
+            component->voltageDrop = voltage;
+            component->currentThrough = current;
         }
     }
+}
 
-    return nodes;
+void Calculator::clearComponentValues(const std::vector<Component*>& components) {
+    for (Component* component : components) {
+        component->currentThrough = 0.0;
+        component->voltageDrop = 0.0;
+    }
 }
 
-void Calculator::getGridNodeFromSpot(GridSpot* spot, GridNode& node) {
-    // Get all spots within the node connected to this spot
-    std::vector<GridSpot*> spots = getNodalNeighboorSpots(spot);
+std::vector<int> Calculator::getSpotNodeIds(const std::vector<GridSpot*>& spots) {
+    PROFILE_SCOPE("getSpotNodeIds");
 
-    // Adds spots to the node if they aren't in it already
-    for (int i = 0; i < spots.size(); i++) {
-        GridSpot* spot = spots[i];
-        bool seen = false;
+    const int n = int(spots.size());
 
-        for (int j = 0; j < node.spots.size() && !seen; j++) {
-            if (spot == node.spots[j])
-                seen = true;
-        }
+    // Index each spot so a wire's endpoints can be found in constant time
+    std::unordered_map<GridSpot*, int> index;
+    index.reserve(n);
+    for (int i = 0; i < n; i++)
+        index[spots[i]] = i;
 
-        if (!seen) {
-            node.spots.push_back(spot);
+    // A node is a section of the circuit that shares a common voltage. In
+    // other words, the node at a point is everything connected to that point
+    // via a wire. Each wire is seen from both of its spots, so it is only
+    // joined from its positive end.
+    DisjointSet sets(n);
 
-            // Get connected spots recursively
-            getGridNodeFromSpot(spot, node);
-        } 
-    }
-}
+    for (int i = 0; i < n; i++) {
+        for (Component* component : spots[i]->components) {
+            if (component->type == &WIRE && component->positive == spots[i]) {
+                auto other = index.find(component->negative);
+                if (other == index.end())
+                    throw std::runtime_error("Calculator::getSpotNodeIds: Wire "
+                                             "is not connected to a populated spot");
 
-std::vector<GridSpot*> Calculator::getNodalNeighboorSpots(GridSpot* spot) {
-    std::vector<GridSpot*> neighboors;
+                sets.unite(i, other->second);
+            }
+        }
+    }
 
-    // Find all spots connected to this spot via wire components
-    for (int i = 0; i < spot->components.size(); i++) {
-        Component* comp = spot->components[i];
+    // Number the sets densely in order of their first spot
+    std::vector<int> rootIds(n, -1),
+                     nodeIds(n);
+    int numNodes = 0;
 
-        if (comp->type == &WIRE)
-            neighboors.push_back(comp->getOther(spot));
+    for (int i = 0; i < n; i++) {
+        int root = sets.find(i);
+        if (rootIds[root] == -1)
+            rootIds[root] = numNodes++;
+        nodeIds[i] = rootIds[root];
     }
 
-    return neighboors;
+    return nodeIds;
 }
 
-std::vector<Node> Calculator::convertGridNodesToNodes(std::vector<GridNode>* gridNodes) {
-    std::vector<Node> nodes;
+Netlist Calculator::buildNetlist(const std::vector<GridSpot*>& spots) {
+    PROFILE_SCOPE("buildNetlist");
 
-    // Initialize Nodes
-    for (int i = 0; i < gridNodes->size(); i++) {
-        Node node(i);
-        gridNodes->at(i).id = i;
-        nodes.push_back(node);
-    }
+    // Node ids are dense, so the number of nodes is one more than the
+    // largest id
+    int nodeCount = 0;
+    for (GridSpot* spot : spots)
+        nodeCount = std::max(nodeCount, spot->node + 1);
 
-    // Form Node connections
-    for (int i = 0; i < nodes.size(); i++) {
-        // List of gridNode components
-        std::vector<Component*> components = gridNodes->at(i).getNonWireComponents();
-
-        for (Component* component : components) {
-            GridNode other;
-
-            // Find the other gridNode this component is connected to
-            for (GridNode gridNode : *gridNodes) {
-                if (gridNode != gridNodes->at(i)) {
-                    for (Component* otherComponent : gridNode.getNonWireComponents()) {
-                        if (otherComponent == component) {
-                            other = gridNode;
-                        }
-                    }
-                }
-            }
+    Netlist netlist(nodeCount);
 
-            Polarity pol = Polarity::UNKNOWN;
+    // Form the branches. Every component is seen from both of its spots,
+    // but it is only added from the spot at its positive end. The nodes at
+    // its ends are simply the nodes of its two spots.
+    for (GridSpot* spot : spots) {
+        for (Component* component : spot->components) {
+            if (component->type == &WIRE || component->positive != spot)
+                continue;
 
-            // Determine polarity
-            for (GridSpot* spot : other.spots) {
-                if (component->positive == spot) {
-                    pol = Polarity::NEGATIVE;
-                } else if (component->negative == spot) {
-                    pol = Polarity::POSITIVE;
-                }
-            }
+            int pos = component->positive->node,
+                neg = component->negative->node;
 
-            if (pol == Polarity::UNKNOWN) {
+            // If wires join both ends of the component, there is no node on
+            // its other end
+            if (pos == neg)
                 throw std::runtime_error("Unable to determine component polarity");
-            }
 
-            // Form connection between this Node and other Node
-            nodes[i].addConnection(
-                &nodes[other.id],
+            netlist.addBranch(
+                pos,
+                neg,
                 component->value,
-                component->type == &RESISTOR ? Unit::OHM : Unit::VOLT,
-                pol
+                component->type == &RESISTOR ? Unit::OHM : Unit::VOLT
             );
         }
     }
 
-    return nodes;
-}
-
-std::vector<Node> Calculator::reduceNodes(std::vector<Node> nodes) {
-    std::vector<Node> reducedNodes = nodes;
-
-    // Call reduceNodeConnection for all possible combinations of Nodes
-    for (int i = 0; i < nodes.size(); i++) {
-        for (int j = 0; j < nodes.size(); j++) {
-            if (i != j) {
-                reduceNodeConnection(&reducedNodes[i], &reducedNodes[j]);
-            }
-        }
-    }
+    PROFILE_COUNT("nodes", netlist.nodeCount);
+    PROFILE_COUNT("branches", netlist.branchCount());
 
-    return reducedNodes;
+    return netlist;
 }
 
-void Calculator::reduceNodeConnection(Node* node1, Node* node2) {
-    // Gets all connections from each node to the other
-    auto node1Tuples = node1->getConnectionsToNode(node2);
-    auto node2Tuples = node2->getConnectionsToNode(node1);
-
-    if (node1Tuples.size() != node2Tuples.size())
-        throw std::runtime_error("Nodes do not share an equal amount of connections");
-
-    // Reduce connections
-    if (node1Tuples.size() > 1) {
-        // Voltages sources cannot be in parallel. If there is more than
-        // one voltage source connection between these nodes, throw an
-        // error.
-        int numVolts = 0;
-        double eqOhms = 0.0;
-
-        int i = 0;
-        while (node1Tuples.size() > 0 && i < node1Tuples.size()) {
-            auto t1 = node1Tuples[i];
-            if (std::get<2>(t1) == Unit::OHM) {
-                eqOhms += 1.0 / std::get<1>(t1);
-
-                // Remove resistor connections. Will be replaced later with
-                // single equivalent connection
-                node1->removeConnection(t1);
-
-                // Search for matching connection from node2 to node1
-                bool found = false;
-                for (auto t2 : node2Tuples) {
-                    if (std::get<0>(t2)->id == node1->id &&
-                        std::get<1>(t2) == std::get<1>(t1) &&
-                        std::get<2>(t2) == std::get<2>(t1) &&
-                        std::get<3>(t2) == !std::get<3>(t1) && !found) {
-                        node2->removeConnection(t2);
-                        found = true;
-                    }
-                }
-
-                // Regather connections node to account for the connection
-                // that was just (possibly) removed
-                // TODO: If statement
-                node1Tuples = node1->getConnectionsToNode(node2);
-                node2Tuples = node2->getConnectionsToNode(node1);
-            } else if (std::get<2>(t1) == Unit::VOLT) {
-                numVolts++;
-                i++;
-            }
-        }
+Netlist Calculator::reduceNodes(const Netlist& netlist) {
+    PROFILE_SCOPE("reduceNodes");
 
-        if (numVolts > 1)
-            throw std::runtime_error("Voltage sources cannot be in parallel "
-                                     "with each other");
+    const int branchCount = netlist.branchCount();
 
-        // Add equivalent resistor connection
-        if (!(fabs(eqOhms) <= 1e-5)) {
-            eqOhms = 1.0 / eqOhms;
-
-            // Resistor polarity is arbitrary, however it is important that 
-            // the polarities be opposite.
-            node1->addConnection(node2, eqOhms, Unit::OHM, Polarity::POSITIVE);
-            node2->addConnection(node1, eqOhms, Unit::OHM, Polarity::NEGATIVE);
-        }
-    }
-}
+    // Parallel branches join the same pair of nodes, so the branches are
+    // grouped by their (lower node, higher node) key in a single pass. Each
+    // group gets an id in the order its first branch appears.
+    std::unordered_map<long long, int> groupIds;
+    std::vector<int> group(branchCount);
+    groupIds.reserve(branchCount);
 
-std::pair<GridNode, GridNode> Calculator::getGridNodesFromComponent(std::vector<GridNode> gridNodes, Component* component) {
-    return std::make_pair(
-        getGridNodeFromSpot(gridNodes, component->positive),
-        getGridNodeFromSpot(gridNodes, component->negative)
-    );;
-}
+    for (int b = 0; b < branchCount; b++) {
+        long long low = std::min(netlist.pos[b], netlist.neg[b]),
+                  high = std::max(netlist.pos[b], netlist.neg[b]);
 
-GridNode Calculator::getGridNodeFromSpot(std::vector<GridNode> gridNodes, GridSpot* spot) {
-    GridNode node;
+        group[b] = groupIds.emplace(low * netlist.nodeCount + high, int(groupIds.size())).first->second;
+    }
 
-    // Find the GridNode that contains the spot
-    for (GridNode gridNode : gridNodes) {
-        for (GridSpot* gridSpot : gridNode.spots) {
-            if (gridSpot == spot) {
-                node = gridNode;
-            }
+    // The branch and voltage source counts of every group, along with the
+    // summed conductance and first branch of its resistors
+    const int groupCount = int(groupIds.size());
+    std::vector<int> numBranches(groupCount, 0),
+                     numVolts(groupCount, 0),
+                     first(groupCount, -1);
+    std::vector<double> eqOhms(groupCount, 0.0);
+
+    for (int b = 0; b < branchCount; b++) {
+        int g = group[b];
+        numBranches[g]++;
+
+        if (netlist.type[b] == Unit::VOLT) {
+            // Voltages sources cannot be in parallel. If there is more than
+            // one voltage source connection between two nodes, throw an
+            // error.
+            if (++numVolts[g] > 1)
+                throw std::runtime_error("Voltage sources cannot be in parallel "
+                                         "with each other");
+        } else {
+            eqOhms[g] += 1.0 / netlist.value[b];
+
+            if (first[g] == -1)
+                first[g] = b;
         }
     }
 
-    return node;
-}
-
-std::vector<Component*> Calculator::getVoltageInputs(Component* component, std::vector<Component*> resistors, int depth) {
-    // Avoid stack overflows due to recursion
-    if (depth > 10)
-        throw std::runtime_error("Calculator::getVoltageInputs: Recursed past 10");
-
-    // Get all connections component and merge into one vector
-    std::vector<Component*> posComps = component->positive->components,
-                            negComps = component->negative->components,
-                            connectedComponents;
-    connectedComponents.reserve(posComps.size() + negComps.size());
-    connectedComponents.insert(connectedComponents.begin(), posComps.begin(), posComps.end());
-    connectedComponents.insert(connectedComponents.begin(), negComps.begin(), negComps.end());
-
-    // Loop through the components
-    for (Component* comp : connectedComponents) {
-        if (comp->type == &RESISTOR && comp->currentThrough > 0.0 &&
-            // The component is a resistor and it has a positive current input.
-            // This contributes positively to the current that goes into the
-            // voltage source, so it gets added.
-            (comp->negative == component->negative || comp->negative == component->positive)) {
-            bool added = false;
-
-            for (Component* resistor : resistors) {
-                if (comp == resistor)
-                    added = true;
-            }
-
-            if (!added)
-                resistors.push_back(comp);
-        } else if (comp->type == &VSRC && comp != component) {
-            // Examine the voltage inputs for any neighbooring voltage sources.
-            std::vector<Component*> newComps = getVoltageInputs(comp, resistors, ++depth);
-            resistors.insert(resistors.end(), newComps.begin(), newComps.end());
+    Netlist reduced(netlist.nodeCount);
+
+    for (int b = 0; b < branchCount; b++) {
+        int g = group[b];
+
+        if (netlist.type[b] == Unit::VOLT || numBranches[g] == 1) {
+            reduced.addBranch(netlist.pos[b], netlist.neg[b], netlist.value[b], netlist.type[b]);
+        } else if (b == first[g]) {
+            // The equivalent resistance of a set of parallel resistors is
+            // written over the first of them, and the rest are removed.
+            // Resistor polarity is arbitrary, so the first resistor's
+            // polarity is kept. eqOhms holds the summed conductance, which
+            // is small for large resistors but only zero if the resistances
+            // cancel out, so every other group with a resistor keeps one.
+            if (eqOhms[g] == 0.0)
+                throw std::runtime_error("Parallel resistors cannot have a total "
+                                         "conductance of zero");
+
+            reduced.addBranch(netlist.pos[b], netlist.neg[b], 1.0 / eqOhms[g], netlist.type[b]);
         }
     }
 
-    return resistors;
+    PROFILE_COUNT("reducedBranches", reduced.branchCount());
+
+    return reduced;
 }
\ No newline at end of file
@@ -5,19 +5,44 @@
                         and current through each component.
     Due Date:           4/25/2018
     Date Created:       4/10/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
 
+#include <map>           // map class
 #include <vector>        // vector class
 #include <utility>       // pair class
 #include "Component.h"
 #include "GridSpot.h"
-#include "GridNode.h"
-#include "Node.h"
+#include "Netlist.h"
+#include "SparseMatrix.h"
+#include "SymbolicCache.h"
 
-typedef std::vector<std::vector<GridSpot*>> spot_vec;
+/**
+    The linear system produced by performing nodal analysis on a circuit,
+    along with enough bookkeeping to map the solution (and later changes to
+    component values) back onto the components.
+*/
+struct NodalSystem {
+    // The number of nodes. The node id of every populated spot is stored
+    // in the spot itself. The ground node (node 0) has no unknown, so the
+    // voltage of every other node is at its KCL row in the solution vector.
+    // The unknowns after the node voltages are the currents through the
+    // voltage sources.
+    int nodeCount = 0;
+
+    SparseMatrix matrix;
+    std::vector<double> coeff;
+
+    // The row holding each node's KCL equation, which is also the column of
+    // its voltage, or -1 for the ground node, which has neither.
+    std::vector<int> kclRows;
+
+    // The row of each voltage source equation, keyed by the ids of the
+    // source's positive and negative nodes.
+    std::map<std::pair<int, int>, int> sourceRows;
+};
 
 namespace Calculator {
     /**
@@ -30,112 +55,122 @@ namespace Calculator {
                        components, respectively.
         Postcondition: The Components will have their current and voltage
                        values modified. All other aspects of the components,
-                       as well as the GridSpots, will remain unmodified.
-    */
-    bool calculate(spot_vec, std::vector<Component*>);
-
-    /**
-        Description:   Converts a vector of GridSpots into a vector of
-                       GridNodes.
-        Return:        vector<GridNode>
-        Precondition:  The vector of GridSpots has been properly initialized
-                       and populated.
-        Postcondition: A vector of GridNodes will be returned. The vector of
-                       GridSpots will not be modified.
+                       as well as the GridSpots (apart from their node ids),
+                       will remain unmodified. Neither vector is copied.
     */
-    std::vector<GridNode> getGridNodes(std::vector<GridSpot*>);
+    bool calculate(const spot_vec&, const std::vector<Component*>&);
 
     /**
-        Description:   Recursively creates a GridNode object given a GridSpot.
-        Return:        GridNode
-        Precondition:  The GridSpot has been properly initialized.
-        Postcondition: The GridNode object passed in will be populated with
-                       the spots that are connected to the GridSpot passed in
-                       via wires (the first step in performing nodal analysis).
-                       The GridSpot object will not be modified.
+        Description:   Returns the cache of symbolic factorizations shared by
+                       every solve, so circuits whose topology has been
+                       solved before only need a numeric factorization.
+        Return:        SymbolicCache
+        Precondition:  None
+        Postcondition: The cache is returned. Its hit and miss counters can be
+                       read to see how often it was used.
     */
-    void getGridNodeFromSpot(GridSpot*, GridNode&);
+    SymbolicCache& getSymbolicCache();
 
     /**
-        Description:   Given a GridSpot, returns all gridspots connected to
-                       that spot via wires. Useful in creating and populating
-                       GridNode objects.
-        Return:        vector<GridSpot>
-        Precondition:  The GridSpot passed in is valid and has been properly
-                       initialized.
-        Postcondition: A vector of neighboor GridSpots will be returned. The
-                       argument passed in will not be modified.
+        Description:   Collects every GridSpot that has a component attached
+                       to it, and checks that the circuit is complete.
+        Return:        bool
+        Precondition:  The spot_vec contains all circuit GridSpots.
+        Postcondition: The populated spots will have been appended to the
+                       vector. Returns false if a component is left dangling
+                       or there are no components at all, true otherwise. The
+                       spot_vec will not be modified.
     */
-    std::vector<GridSpot*> getNodalNeighboorSpots(GridSpot*);
+    bool getPopulatedSpots(const spot_vec&, std::vector<GridSpot*>&);
 
     /**
-        Description:   Converts the "rough" GridNode objects into fully 
-                       abstract Node objects.
-        Return:        vector<Node>
-        Precondition:  The vector passed in contains GridNodes that have been
-                       properly initialized from the circuit.
-        Postcondition: A vector of populated Node objects will be returned. The
-                       argument will be modified in that the GridNodes will be
-                       given IDs that correspond to their derived Node objects.
-                       Can throw a runtime_error if a component's polarity has
-                       been improperly set.
+        Description:   Performs modified nodal analysis on a complete circuit
+                       and builds the linear system for its node voltages and
+                       voltage source currents. Every branch of the Netlist
+                       adds its stamp to the matrix in a single pass.
+        Return:        NodalSystem
+        Precondition:  The vector contains every populated GridSpot of a
+                       complete circuit (see getPopulatedSpots()).
+        Postcondition: The system will be returned. Its matrix is square, with
+                       one row per node other than ground followed by one row
+                       per voltage source. Each spot will have its node id
+                       set, and will not be modified otherwise. Throws a
+                       runtime_error if the circuit cannot be analyzed (eg:
+                       voltage sources in parallel).
     */
-    std::vector<Node> convertGridNodesToNodes(std::vector<GridNode>*);
+    NodalSystem buildSystem(const std::vector<GridSpot*>&);
 
     /**
-        Description:   Reduces all nodes. This simply reduces parallel 
-                       resistors to single resistors, and ensures there are no
-                       voltage sources in parallel.
-        Return:        vector<Node>
-        Precondition:  The vector passed in contains Node objects that have
-                       been properly initialized from the circuit.
-        Postcondition: A vector of populated Node objects will be returned. The
-                       argument will not be modified. If two voltage sources
-                       are found to be in parallel, a runtime_error is thrown.
+        Description:   Sets the voltage drop and current of every component
+                       from the solution of a NodalSystem.
+        Return:        void
+        Precondition:  The solution vector holds the solution of the
+                       system, and every component was part of the circuit
+                       the system was built from.
+        Postcondition: The components will have their current and voltage
+                       values modified. The system will not be modified.
     */
-    std::vector<Node> reduceNodes(std::vector<Node>);
+    void setComponentValues(const NodalSystem&, std::vector<double>, const std::vector<Component*>&);
 
     /**
-        Description:   Reduces the connection between two nodes (ie: reduces
-                       parallel resistors).
+        Description:   Sets the voltage drop and current of every component to
+                       zero.
         Return:        void
-        Precondition:  The Node objects passed in have been properly 
-                       initialized and have valid connections.
-        Postcondition: The Node arguments will have been modified if they share
-                       parallel resistor connections. If two voltage sources
-                       are found to be in parallel, a runtime_error is thrown.
-                       A runtime_error is also thrown if the two nodes do not
-                       share the same number of connections to each other.
+        Precondition:  The components have been initialized.
+        Postcondition: The components will have their current and voltage
+                       values set to zero.
     */
-    void reduceNodeConnection(Node*, Node*);
+    void clearComponentValues(const std::vector<Component*>&);
 
     /**
-        Description:   Given a list of all GridNodes and a specific Component,
-                       gets the two GridNode objects that the Component is
-                       connected to.
-        Return:        pair<GridNode, GridNode>
-        Precondition:  The GridNode vector contains all circuit GridNodes.
-        Postcondition: A pair of GridNodes will be returns that correspond to
-                       the GridNodes that surround the Component. The first
-                       GridNode in the pair will always correspond to the
-                       positive end of the Component. The arguments will not be
-                       modified.
+        Description:   Groups the GridSpots that are connected to each other
+                       via wires (the first step in performing nodal
+                       analysis). Every wire joins the sets of its two spots
+                       in a DisjointSet, so the grouping takes linear time
+                       and does not recurse.
+        Return:        vector<int>
+        Precondition:  The vector contains every populated GridSpot, so both
+                       ends of every wire are in it.
+        Postcondition: A vector with one entry per GridSpot is returned,
+                       holding the id of the node the spot belongs to. Node
+                       ids are numbered from zero in the order their first
+                       spot appears. The vector of GridSpots will not be
+                       modified. Throws a runtime_error if a wire ends on a
+                       spot that is not in the vector.
     */
-    std::pair<GridNode, GridNode> getGridNodesFromComponent(std::vector<GridNode>, Component*);
+    std::vector<int> getSpotNodeIds(const std::vector<GridSpot*>&);
 
     /**
-        Description:   Given a vector of GridNodes and a specific GridSpot,
-                       returns the GridNode that encapsulates the GridSpot.
-        Return:        GridNode
-        Precondition:  The GridNode vector contains all circuit GridNodes, and
-                       the GridSpot is a valid spot on the Grid.
-        Postcondition: The GridNode that encapsulates the GridSpot will be
-                       returned. The arguments will not be modified.
+        Description:   Converts the populated GridSpots into a fully abstract
+                       Netlist, with one branch per non-wire component. The
+                       nodes at a component's ends are looked up from the
+                       node id of each spot, so every component is handled in
+                       constant time.
+        Return:        Netlist
+        Precondition:  Every spot of every component is in the vector, and
+                       every spot in the vector has had its node id set from
+                       getSpotNodeIds().
+        Postcondition: A Netlist whose node ids are the spots' node ids will
+                       be returned. The spots will not be modified. Can
+                       throw a runtime_error if both ends of a component are
+                       in the same node.
     */
-    GridNode getGridNodeFromSpot(std::vector<GridNode>, GridSpot*);
+    Netlist buildNetlist(const std::vector<GridSpot*>&);
 
     /**
-        Description:   
+        Description:   Reduces all nodes. This simply reduces parallel 
+                       resistors to single resistors, and ensures there are no
+                       voltage sources in parallel. Branches are grouped by
+                       the pair of nodes they join with a hash map, so the
+                       reduction takes linear time in the number of branches.
+        Return:        Netlist
+        Precondition:  The Netlist passed in has been properly built from the
+                       circuit.
+        Postcondition: A reduced Netlist with the same nodes will be returned.
+                       The argument will not be modified. If two voltage
+                       sources are found to be in parallel, or parallel
+                       resistors have a total conductance of zero, a
+                       runtime_error is thrown.
     */
-    std::vector<Component*> getVoltageInputs(Component*, std::vector<Component*> = std::vector<Component*>(), int = 0);
+    Netlist reduceNodes(const Netlist&);
 }
\ No newline at end of file
@@ -0,0 +1,64 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Circuit.cpp
+    File Description:   Implements the Circuit class. This class stores a set
+                        of named components and the GridSpots they are
+                        connected to, without any of the windowing done by
+                        Grid.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include "Circuit.h"
+
+long long Circuit::getKey(int x, int y) {
+    return (long long)(unsigned(x)) << 32 | (long long)(unsigned(y));
+}
+
+void Circuit::reserve(std::size_t componentCount, std::size_t spotCount) {
+    components.reserve(componentCount);
+    names.reserve(componentCount);
+    spots[0].reserve(spotCount);
+    spotMap.reserve(spotCount);
+}
+
+GridSpot* Circuit::getSpot(int x, int y) {
+    GridSpot*& spot = spotMap[getKey(x, y)];
+
+    if (spot == nullptr) {
+        spotStorage.emplace_back(x, y);
+        spot = &spotStorage.back();
+        spots[0].push_back(spot);
+    }
+
+    return spot;
+}
+
+Component* Circuit::addComponent(const std::string& name, const ComponentType* type,
+                                 int x1, int y1, int x2, int y2, double value) {
+    componentStorage.emplace_back(type);
+    Component* component = &componentStorage.back();
+    component->value = value;
+    component->positive = getSpot(x1, y1);
+    component->negative = getSpot(x2, y2);
+
+    component->positive->components.push_back(component);
+    component->negative->components.push_back(component);
+
+    components.push_back(component);
+    names.push_back(name);
+
+    return component;
+}
+
+const std::vector<Component*>& Circuit::getComponents() const {
+    return components;
+}
+
+const spot_vec& Circuit::getSpots() const {
+    return spots;
+}
+
+const std::string& Circuit::getName(int index) const {
+    return names.at(index);
+}
\ No newline at end of file
@@ -0,0 +1,122 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Circuit.h
+    File Description:   Declares the Circuit class. This class stores a set of
+                        named components and the GridSpots they are connected
+                        to, without any of the windowing done by Grid. It is
+                        used to build and solve circuits from the command line.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstddef>         // size_t
+#include <deque>           // deque class
+#include <string>          // string class
+#include <unordered_map>   // unordered_map class
+#include <vector>          // vector class
+#include "Component.h"
+#include "ComponentTypes.h"
+#include "GridSpot.h"
+
+class Circuit {
+    private:
+        // Spots are created the first time a component is attached to their
+        // lattice point, and are looked up by getKey() of their coordinates.
+        std::unordered_map<long long, GridSpot*> spotMap;
+
+        // The spots and components themselves. A deque never moves its
+        // elements, so they can be pointed to, and allocates them in blocks
+        // rather than one at a time.
+        std::deque<GridSpot> spotStorage;
+        std::deque<Component> componentStorage;
+
+        // Every spot in the circuit, stored as a single row
+        spot_vec spots = spot_vec(1);
+
+        std::vector<Component*> components;
+        std::vector<std::string> names;
+
+        /**
+            Description:   Returns the key of a lattice point in spotMap.
+            Return:        long long
+            Precondition:  None
+            Postcondition: A key unique to the lattice point is returned.
+        */
+        static long long getKey(int, int);
+
+    public:
+        /**
+            Description:   Initializes an empty Circuit object.
+            Return:        None
+            Precondition:  None
+            Postcondition: A Circuit with no components is returned.
+        */
+        Circuit() = default;
+
+        // The Circuit owns its spots and components, so it cannot be copied
+        Circuit(const Circuit&) = delete;
+        Circuit& operator =(const Circuit&) = delete;
+
+        /**
+            Description:   Prepares the circuit to hold a number of components
+                           and spots without growing its indices.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: Adding up to the provided number of components and
+                           spots will not rehash or reallocate the indices.
+        */
+        void reserve(std::size_t, std::size_t);
+
+        /**
+            Description:   Returns the spot at the provided lattice point,
+                           creating it if it does not exist yet.
+            Return:        GridSpot*
+            Precondition:  This object exists.
+            Postcondition: The spot at the lattice point is returned.
+        */
+        GridSpot* getSpot(int, int);
+
+        /**
+            Description:   Creates a component of the provided type and value
+                           between two lattice points, and attaches it to the
+                           spots at those points. The first point is the
+                           positive end of the component.
+            Return:        Component*
+            Precondition:  This object exists, and the type is valid.
+            Postcondition: The new component is returned. It will have been
+                           added to the components vector and to both of its
+                           spots.
+        */
+        Component* addComponent(const std::string&, const ComponentType*,
+                                int, int, int, int, double);
+
+        /**
+            Description:   Returns the components vector.
+            Return:        vector<Component*>
+            Precondition:  This object exists.
+            Postcondition: The components vector will be returned. This object
+                           will not be modified.
+        */
+        const std::vector<Component*>& getComponents() const;
+
+        /**
+            Description:   Returns the spots vector.
+            Return:        spot_vec
+            Precondition:  This object exists.
+            Postcondition: The spots vector will be returned as a single row.
+                           This object will not be modified.
+        */
+        const spot_vec& getSpots() const;
+
+        /**
+            Description:   Returns the name of the component at the provided
+                           index of the components vector.
+            Return:        string
+            Precondition:  The index is within the components vector.
+            Postcondition: The component's name is returned. This object will
+                           not be modified.
+        */
+        const std::string& getName(int) const;
+};
\ No newline at end of file
@@ -0,0 +1,115 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         CircuitFile.cpp
+    File Description:   Implements methods to read a Circuit from a file and
+                        save it to one.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <cctype>         // tolower, toupper
+#include <fstream>        // ifstream class
+#include <sstream>        // istringstream class
+#include <stdexcept>      // runtime_error
+#include "BinaryCircuitFile.h"
+#include "CircuitFile.h"
+#include "SpiceFile.h"
+
+namespace {
+    /**
+        Description:   Returns whether a path names a SPICE netlist.
+        Return:        bool
+        Precondition:  None
+        Postcondition: Returns true if the path ends in .cir, .sp or .spice,
+                       in any case.
+    */
+    bool isSpicePath(const std::string& path) {
+        std::size_t dot = path.find_last_of("./\\");
+        if (dot == std::string::npos || path[dot] != '.')
+            return false;
+
+        std::string extension = path.substr(dot + 1);
+        for (char& ch : extension)
+            ch = char(tolower((unsigned char)ch));
+
+        return extension == "cir" || extension == "sp" || extension == "spice";
+    }
+}
+
+void CircuitFile::read(std::istream& in, Circuit& circuit) {
+    std::string line;
+    int lineNumber = 0;
+
+    while (std::getline(in, line)) {
+        lineNumber++;
+
+        std::istringstream ss(line);
+        std::string name;
+        int x1, y1, x2, y2;
+        double value = 0.0;
+
+        // Skip blank lines and comments
+        if (!(ss >> name) || name[0] == '#')
+            continue;
+
+        const ComponentType* type = nullptr;
+        switch (toupper(name[0])) {
+            case 'W':
+                type = &WIRE;
+                break;
+            case 'R':
+                type = &RESISTOR;
+                break;
+            case 'V':
+                type = &VSRC;
+                break;
+        }
+
+        if (type == nullptr)
+            throw std::runtime_error("line " + std::to_string(lineNumber) +
+                                     ": Unknown component type '" + name + "'");
+
+        if (!(ss >> x1 >> y1 >> x2 >> y2))
+            throw std::runtime_error("line " + std::to_string(lineNumber) +
+                                     ": Expected four coordinates");
+
+        if (!(ss >> value) && type != &WIRE)
+            throw std::runtime_error("line " + std::to_string(lineNumber) +
+                                     ": Expected a value for " + name);
+
+        circuit.addComponent(name, type, x1, y1, x2, y2, value);
+    }
+}
+
+void CircuitFile::load(const std::string& path, Circuit& circuit) {
+    if (isSpicePath(path)) {
+        SpiceFile::load(path, circuit);
+        return;
+    }
+
+    if (BinaryCircuitFile::isBinary(path)) {
+        BinaryCircuitFile(path).read(circuit);
+        return;
+    }
+
+    std::ifstream in(path);
+
+    if (!in)
+        throw std::runtime_error("Unable to open " + path);
+
+    read(in, circuit);
+}
+
+void CircuitFile::save(const std::string& path, const Circuit& circuit) {
+    const std::vector<Component*>& components = circuit.getComponents();
+    std::vector<std::string> names;
+
+    names.reserve(components.size());
+    for (std::size_t i = 0; i < components.size(); i++)
+        names.push_back(circuit.getName(int(i)));
+
+    if (isSpicePath(path))
+        SpiceFile::save(path, components, names);
+    else
+        BinaryCircuitFile::write(path, components, names);
+}
\ No newline at end of file
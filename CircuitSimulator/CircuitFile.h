@@ -0,0 +1,66 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         CircuitFile.h
+    File Description:   Declares methods to read and save a Circuit. In a text
+                        circuit file, each non-empty line that does not start
+                        with '#' describes one component:
+
+                            <name> <x1> <y1> <x2> <y2> [value]
+
+                        The first letter of the name selects the component
+                        type (W for wire, R for resistor, V for voltage
+                        source). The coordinates are lattice points, and the
+                        first point is the positive end of the component.
+                        Wires do not need a value. Circuits can also be saved
+                        to and loaded from binary files (see
+                        BinaryCircuitFile.h) and SPICE netlists (see
+                        SpiceFile.h).
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <istream>      // istream class
+#include <string>       // string class
+#include "Circuit.h"
+
+namespace CircuitFile {
+    /**
+        Description:   Reads every component from the stream into the
+                       circuit.
+        Return:        void
+        Precondition:  The stream is open and the circuit has been
+                       initialized.
+        Postcondition: The components described by the stream will have been
+                       added to the circuit. Throws a runtime_error naming the
+                       offending line if a line cannot be parsed.
+    */
+    void read(std::istream&, Circuit&);
+
+    /**
+        Description:   Opens the file at the provided path and reads it into
+                       the circuit. Binary circuit files are recognized by
+                       their header, and SPICE netlists by a .cir, .sp or
+                       .spice extension; any other file is read as text.
+        Return:        void
+        Precondition:  The circuit has been initialized.
+        Postcondition: The components described by the file will have been
+                       added to the circuit. Throws a runtime_error if the
+                       file cannot be opened or parsed.
+    */
+    void load(const std::string&, Circuit&);
+
+    /**
+        Description:   Saves the circuit, including its component names, to
+                       the provided path. Paths with a .cir, .sp or .spice
+                       extension are written as SPICE netlists; any other
+                       path is written as a binary circuit file.
+        Return:        void
+        Precondition:  None
+        Postcondition: The file will have been written. Throws a
+                       runtime_error if it cannot be. The circuit is not
+                       modified.
+    */
+    void save(const std::string&, const Circuit&);
+}
\ No newline at end of file
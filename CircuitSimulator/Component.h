@@ -7,7 +7,7 @@
                         about the component, depending on its ComponentType.
     Due Date:           4/25/2018
     Date Created:       3/25/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
@@ -36,7 +36,9 @@ struct Component {
         Postcondition: A Component object will be initialize with the specified
                        type and a default value of 5.0.
     */
-    inline Component(const ComponentType* type) : type(type), value(5.0) { }
+    inline Component(const ComponentType* type) : type(type), value(5.0),
+        voltageDrop(0.0), currentThrough(0.0), positive(nullptr),
+        negative(nullptr) { }
 
     /**
         Description:   If this component is connected to the provided spot, 
@@ -0,0 +1,220 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         ComponentBatch.cpp
+    File Description:   Implements the ComponentBatch class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // max, sort, lower_bound
+#include <cmath>          // sin, cos, atan2, sqrt
+#include <functional>     // less class
+#include "ComponentBatch.h"
+#include "Config.h"
+#include "GridSpot.h"
+
+namespace {
+    // The endpoint circle has a radius of 5 pixels and a 1 pixel outline
+    const int ENDPOINT_SIZE = 12;
+
+    // The space left between glyphs in the atlas, so smoothing does not mix
+    // neighbouring glyphs
+    const int ATLAS_PADDING = 2;
+
+    // The components are built in lattice units, but are sized in pixels at
+    // the default zoom, where lattice points are SPOT_SPACING pixels apart
+    const float PIXEL = 1.0f / float(SPOT_SPACING);
+
+    /**
+        Description:   Appends a rotated, textured rectangle as two triangles.
+        Return:        void
+        Precondition:  The vertex array holds triangles.
+        Postcondition: The rectangle with its top left corner at corner (in
+                       its own, unrotated space) is rotated by radians about
+                       the origin, moved to position and appended.
+    */
+    void appendQuad(sf::VertexArray& vertices, sf::Vector2f position, float radians,
+                    sf::Vector2f corner, sf::Vector2f size, const sf::FloatRect& texture,
+                    sf::Color color) {
+        float c = cos(radians),
+              s = sin(radians);
+
+        const sf::Vector2f local[4] = {
+            corner,
+            corner + sf::Vector2f(size.x, 0.0f),
+            corner + size,
+            corner + sf::Vector2f(0.0f, size.y)
+        };
+        const sf::Vector2f texCoords[4] = {
+            { texture.left, texture.top },
+            { texture.left + texture.width, texture.top },
+            { texture.left + texture.width, texture.top + texture.height },
+            { texture.left, texture.top + texture.height }
+        };
+
+        sf::Vertex corners[4];
+        for (int i = 0; i < 4; i++) {
+            corners[i] = sf::Vertex(position + sf::Vector2f(local[i].x * c - local[i].y * s,
+                                                            local[i].x * s + local[i].y * c),
+                                    color, texCoords[i]);
+        }
+
+        for (int i : { 0, 1, 2, 0, 2, 3 })
+            vertices.append(corners[i]);
+    }
+}
+
+ComponentBatch::ComponentBatch() : vertices(sf::Triangles) { }
+
+bool ComponentBatch::loadTextures(const std::string& resistorFile, const std::string& sourceFile) {
+    sf::Image resistor,
+              source;
+
+    if (!resistor.loadFromFile(resistorFile) || !source.loadFromFile(sourceFile))
+        return false;
+
+    // The glyphs are packed side by side: resistor, voltage source, endpoint
+    // circle, then a small white square
+    unsigned sourceX = resistor.getSize().x + ATLAS_PADDING,
+             endpointX = sourceX + source.getSize().x + ATLAS_PADDING,
+             whiteX = endpointX + ENDPOINT_SIZE + ATLAS_PADDING,
+             width = whiteX + 4,
+             height = std::max(std::max(resistor.getSize().y, source.getSize().y), unsigned(ENDPOINT_SIZE));
+
+    sf::Image image;
+    image.create(width, height, sf::Color::Transparent);
+    image.copy(resistor, 0, 0);
+    image.copy(source, sourceX, 0);
+
+    // The endpoint circle is white, so it takes the component's color, with
+    // a gray outline
+    for (int y = 0; y < ENDPOINT_SIZE; y++) {
+        for (int x = 0; x < ENDPOINT_SIZE; x++) {
+            float dx = float(x) + 0.5f - ENDPOINT_SIZE / 2.0f,
+                  dy = float(y) + 0.5f - ENDPOINT_SIZE / 2.0f,
+                  distance = sqrt(dx * dx + dy * dy);
+
+            if (distance <= 5.0f)
+                image.setPixel(endpointX + x, y, sf::Color::White);
+            else if (distance <= 6.0f)
+                image.setPixel(endpointX + x, y, { 120, 120, 120 });
+        }
+    }
+
+    for (unsigned y = 0; y < 4; y++) {
+        for (unsigned x = 0; x < 4; x++)
+            image.setPixel(whiteX + x, y, sf::Color::White);
+    }
+
+    resistorRect = sf::FloatRect(0.0f, 0.0f, float(resistor.getSize().x), float(resistor.getSize().y));
+    sourceRect = sf::FloatRect(float(sourceX), 0.0f, float(source.getSize().x), float(source.getSize().y));
+    endpointRect = sf::FloatRect(float(endpointX), 0.0f, float(ENDPOINT_SIZE), float(ENDPOINT_SIZE));
+
+    // Untextured vertices all sample the middle of the white square
+    whiteRect = sf::FloatRect(float(whiteX) + 2.0f, 2.0f, 0.0f, 0.0f);
+
+    atlas.loadFromImage(image);
+    atlas.setSmooth(true);
+
+    return true;
+}
+
+const sf::Texture& ComponentBatch::getTexture() const {
+    return atlas;
+}
+
+void ComponentBatch::rebuild(const std::vector<Component*>& components) {
+    vertices.clear();
+    ranges.clear();
+    ranges.reserve(components.size());
+    hovered = nullptr;
+    selected = nullptr;
+
+    for (const Component* component : components) {
+        std::size_t first = vertices.getVertexCount();
+
+        append(vertices, component->type,
+               sf::Vector2f(float(component->positive->x), float(component->positive->y)),
+               sf::Vector2f(float(component->negative->x), float(component->negative->y)),
+               COMPONENT_COLOR);
+
+        ranges.push_back({ component, first, vertices.getVertexCount() - first });
+    }
+
+    std::sort(ranges.begin(), ranges.end(), [](const Range& a, const Range& b) {
+        return std::less<const Component*>()(a.component, b.component);
+    });
+}
+
+void ComponentBatch::append(sf::VertexArray& target, const ComponentType* type, sf::Vector2f posSpot,
+                            sf::Vector2f negSpot, sf::Color color) const {
+    // Draw component endpoints
+    sf::Vector2f endpointCorner(-ENDPOINT_SIZE / 2.0f * PIXEL, -ENDPOINT_SIZE / 2.0f * PIXEL),
+                 endpointSize(ENDPOINT_SIZE * PIXEL, ENDPOINT_SIZE * PIXEL);
+
+    appendQuad(target, posSpot, 0.0f, endpointCorner, endpointSize, endpointRect, color);
+    appendQuad(target, negSpot, 0.0f, endpointCorner, endpointSize, endpointRect, color);
+
+    // Get length and angle of the component.
+    sf::Vector2f delta = posSpot - negSpot;
+    float length = sqrt(delta.x * delta.x + delta.y * delta.y),
+          radians = PI + atan2(delta.y, delta.x);
+
+    // The lines are offset by one pixel, so they are centered on the
+    // endpoints
+    sf::Vector2f offset(sin(radians) * PIXEL, -cos(radians) * PIXEL);
+
+    if (type == &WIRE) {
+        appendQuad(target, posSpot + offset, radians, { 0.0f, 0.0f }, { length, 2.0f * PIXEL },
+                   whiteRect, color);
+        return;
+    }
+
+    // Draw different glyphs depending on component types (with slightly
+    // different positions)
+    const sf::FloatRect& glyph = type == &RESISTOR ? resistorRect : sourceRect;
+    sf::Vector2f glyphSize(glyph.width * PIXEL, glyph.height * PIXEL);
+    sf::Vector2f glyphPos = posSpot - delta / 2.0f +
+                            sf::Vector2f(sin(radians) * glyphSize.x / (type == &RESISTOR ? 4.0f : 2.0f),
+                                         -cos(radians) * glyphSize.y / 2.0f);
+
+    // A line from each endpoint to the glyph
+    sf::Vector2f lineSize(0.5f * (length - glyphSize.x), 2.0f * PIXEL);
+
+    appendQuad(target, posSpot + offset, radians, { 0.0f, 0.0f }, lineSize, whiteRect, color);
+    appendQuad(target, negSpot - offset, radians + PI, { 0.0f, 0.0f }, lineSize, whiteRect, color);
+    appendQuad(target, glyphPos, radians, { -glyphSize.x / 2.0f, 0.0f }, glyphSize, glyph, color);
+}
+
+void ComponentBatch::setHighlights(const Component* hovered_, const Component* selected_) {
+    if (hovered_ == hovered && selected_ == selected)
+        return;
+
+    setColor(hovered, COMPONENT_COLOR);
+    setColor(selected, COMPONENT_COLOR);
+
+    hovered = hovered_;
+    selected = selected_;
+
+    // The selected color wins if a component is both
+    setColor(hovered, COMPONENT_HOVER_COLOR);
+    setColor(selected, COMPONENT_SELECTED_COLOR);
+}
+
+void ComponentBatch::setColor(const Component* component, sf::Color color) {
+    auto range = std::lower_bound(ranges.begin(), ranges.end(), component,
+                                  [](const Range& a, const Component* b) {
+        return std::less<const Component*>()(a.component, b);
+    });
+
+    if (range == ranges.end() || range->component != component)
+        return;
+
+    for (std::size_t i = range->first; i < range->first + range->count; i++)
+        vertices[i].color = color;
+}
+
+void ComponentBatch::draw(sf::RenderTarget& target, sf::RenderStates states) const {
+    states.texture = &atlas;
+    target.draw(vertices, states);
+}
\ No newline at end of file
@@ -0,0 +1,135 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         ComponentBatch.h
+    File Description:   Declares the ComponentBatch class, which draws every
+                        component on the grid with a single draw call. The
+                        components are built into one vertex array, in
+                        lattice units, and every glyph they use (the resistor
+                        and voltage source images and the endpoint circles)
+                        is packed into one texture atlas. The array is only
+                        rebuilt when components are added or removed; panning
+                        and zooming only change the transform it is drawn
+                        with.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstddef>            // size_t
+#include <string>             // string class
+#include <vector>             // vector class
+#include <SFML/Graphics.hpp>  // Objects: Drawable, Texture, VertexArray
+#include "Component.h"
+#include "ComponentTypes.h"
+
+class ComponentBatch : public sf::Drawable {
+    private:
+        sf::Texture atlas;
+
+        // Where each glyph is in the atlas. The white rectangle is used for
+        // the parts of a component that are not textured.
+        sf::FloatRect resistorRect,
+                      sourceRect,
+                      endpointRect,
+                      whiteRect;
+
+        // Every component, as a list of triangles
+        sf::VertexArray vertices;
+
+        // The first vertex and number of vertices of a component
+        struct Range {
+            const Component* component;
+            std::size_t first,
+                        count;
+        };
+
+        // The range of every component, sorted by the component's address
+        // so a component's range can be found with a binary search
+        std::vector<Range> ranges;
+
+        // The components drawn in the hover and selected colors
+        const Component* hovered = nullptr;
+        const Component* selected = nullptr;
+
+        /**
+            Description:   Sets the color of every vertex of a component.
+            Return:        void
+            Precondition:  None
+            Postcondition: If the component is in the batch, it will be drawn
+                           in the color.
+        */
+        void setColor(const Component*, sf::Color);
+
+        /**
+            Description:   Draws every component.
+            Return:        void
+            Precondition:  The states transform lattice units to the target's
+                           coordinates (see Grid::getTransform()).
+            Postcondition: The components are drawn to the target with one
+                           draw call.
+        */
+        virtual void draw(sf::RenderTarget&, sf::RenderStates) const override;
+
+    public:
+        /**
+            Description:   Initializes an empty ComponentBatch object.
+            Return:        None
+            Precondition:  None
+            Postcondition: A ComponentBatch with no components or textures is
+                           returned.
+        */
+        ComponentBatch();
+
+        /**
+            Description:   Loads the resistor and voltage source images, and
+                           packs them into the atlas along with the endpoint
+                           circle.
+            Return:        bool
+            Precondition:  None
+            Postcondition: Returns false if either image could not be loaded.
+        */
+        bool loadTextures(const std::string&, const std::string&);
+
+        /**
+            Description:   Returns the atlas texture.
+            Return:        Texture
+            Precondition:  None
+            Postcondition: The atlas is returned. This object will not be
+                           modified.
+        */
+        const sf::Texture& getTexture() const;
+
+        /**
+            Description:   Rebuilds the vertex array from the components.
+            Return:        void
+            Precondition:  Every component is connected to two spots.
+            Postcondition: Every component will be drawn in COMPONENT_COLOR.
+                           The vertex array and the ranges keep their memory,
+                           so rebuilding a circuit of the same size does not
+                           allocate.
+        */
+        void rebuild(const std::vector<Component*>&);
+
+        /**
+            Description:   Appends the triangles of a component of a type
+                           between two lattice points to a vertex array.
+            Return:        void
+            Precondition:  The vertex array holds triangles.
+            Postcondition: The triangles are appended. This object will not be
+                           modified.
+        */
+        void append(sf::VertexArray&, const ComponentType*, sf::Vector2f, sf::Vector2f, sf::Color) const;
+
+        /**
+            Description:   Sets the components drawn in the hover and selected
+                           colors. Either can be null.
+            Return:        void
+            Precondition:  None
+            Postcondition: The previously highlighted components are drawn in
+                           COMPONENT_COLOR again, and the new ones in
+                           COMPONENT_HOVER_COLOR and COMPONENT_SELECTED_COLOR.
+                           Only their vertices are changed.
+        */
+        void setHighlights(const Component*, const Component*);
+};
\ No newline at end of file
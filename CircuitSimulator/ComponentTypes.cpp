@@ -12,16 +12,16 @@ const ComponentType WIRE("Wire");
 const ComponentType RESISTOR("Resistor");
 const ComponentType VSRC("Voltage Source");
 
-void shift(const ComponentType*& type, sf::Keyboard::Key key) {
+void shift(const ComponentType*& type, ShiftDirection direction) {
     // Shift the type according to the order of components listed above.
     // Will wrap the type.
-    switch (key) {
-        case sf::Keyboard::Up:
+    switch (direction) {
+        case ShiftDirection::UP:
             if (type == &WIRE) type = &VSRC;
             else if (type == &RESISTOR) type = &WIRE;
             else if (type == &VSRC) type = &RESISTOR;
             break;
-        case sf::Keyboard::Down:
+        case ShiftDirection::DOWN:
             if (type == &WIRE) type = &RESISTOR;
             else if (type == &RESISTOR) type = &VSRC;
             else if (type == &VSRC) type = &WIRE;
@@ -6,13 +6,21 @@
                         as a sort of Component Type Enum.
     Due Date:           4/25/2018
     Date Created:       3/25/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
 
 #include <string>
-#include <SFML/Window/Keyboard.hpp>
+
+/**
+    The direction to shift a ComponentType pointer in. UP moves to the
+    previous type in the list of valid types, and DOWN moves to the next one.
+*/
+enum class ShiftDirection {
+    UP,
+    DOWN
+};
 
 struct ComponentType {
     std::string name;
@@ -45,9 +53,8 @@ extern const ComponentType VSRC;
     Description:   Shifts the provided component type pointer given a
                    direction.
     Return:        void
-    Precondition:  The ComponentType pointer reference is valid, and the key
-                   has been properly set.
-    Postcondition: The ComponentType pointer will have been changed. The key
-                   will not be modified.
+    Precondition:  The ComponentType pointer reference is valid.
+    Postcondition: The ComponentType pointer will have been changed. The
+                   direction will not be modified.
 */
-void shift(const ComponentType*&, sf::Keyboard::Key);
\ No newline at end of file
+void shift(const ComponentType*&, ShiftDirection);
\ No newline at end of file
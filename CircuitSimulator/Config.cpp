@@ -6,7 +6,7 @@
                         without redeclaration.
     Due Date:           4/25/2018
     Date Created:       3/26/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #include "Config.h"
@@ -26,6 +26,16 @@ sf::Font getDefaultFont() {
 int SCREEN_WIDTH = 1600;
 int SCREEN_HEIGHT = 900;
 
+// If true, the window is redrawn every frame. Else, the application waits
+// for an event and only redraws when something has changed.
+const bool CONTINUOUS_RENDERING = false;
+
+// The file the circuit is saved to with Ctrl+S, and loaded from with Ctrl+O
+const std::string CIRCUIT_FILE = "circuit.bin";
+
+// The file the circuit is exported to as a SPICE netlist with Ctrl+E
+const std::string SPICE_FILE = "circuit.cir";
+
 // GUI
 const int GUI_X_PADDING = 30;
 const int GUI_Y_PADDING = 30;
@@ -34,6 +44,8 @@ const sf::Color BORDER_COLOR = { 200, 200, 200 };
 
 // GRID
 const int SPOT_SPACING = 40;
+const float MIN_SPOT_SPACING = 5.0f;
+const float MAX_SPOT_SPACING = 160.0f;
 const int GRID_TOP_OFFSET = GUI_Y_PADDING;
 const int GRID_BOTTOM_OFFSET = GUI_Y_PADDING;
 const int GRID_LEFT_OFFSET = 350;
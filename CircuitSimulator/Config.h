@@ -6,7 +6,7 @@
                         redeclaration.
     Due Date:           4/25/2018
     Date Created:       3/26/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
@@ -22,6 +22,9 @@ extern void set(int width, int height);
 // Application
 extern int SCREEN_WIDTH;
 extern int SCREEN_HEIGHT;
+extern const bool CONTINUOUS_RENDERING;
+extern const std::string CIRCUIT_FILE;
+extern const std::string SPICE_FILE;
 
 // GUI
 extern const int GUI_X_PADDING;
@@ -49,6 +52,8 @@ extern sf::Vector2f PANEL_INFO_4;
 	
 // Grid
 extern const int SPOT_SPACING;
+extern const float MIN_SPOT_SPACING;
+extern const float MAX_SPOT_SPACING;
 extern const int GRID_TOP_OFFSET;
 extern const int GRID_BOTTOM_OFFSET;
 extern const int GRID_LEFT_OFFSET;
@@ -0,0 +1,41 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         DisjointSet.cpp
+    File Description:   Implements the DisjointSet class, a union-find
+                        structure over the integers 0 to n - 1.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <utility>          // swap
+#include "DisjointSet.h"
+
+DisjointSet::DisjointSet(int n) : parent(n), size(n, 1) {
+    for (int i = 0; i < n; i++)
+        parent[i] = i;
+}
+
+int DisjointSet::find(int i) {
+    // Path halving: point every other element on the path at its
+    // grandparent while walking up to the root.
+    while (parent[i] != i) {
+        parent[i] = parent[parent[i]];
+        i = parent[i];
+    }
+
+    return i;
+}
+
+void DisjointSet::unite(int a, int b) {
+    a = find(a);
+    b = find(b);
+
+    if (a == b)
+        return;
+
+    if (size[a] < size[b])
+        std::swap(a, b);
+
+    parent[b] = a;
+    size[a] += size[b];
+}
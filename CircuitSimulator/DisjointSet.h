@@ -0,0 +1,49 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         DisjointSet.h
+    File Description:   Declares the DisjointSet class, a union-find structure
+                        over the integers 0 to n - 1. Used to group GridSpots
+                        that are connected by wires into nodes.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <vector>   // vector class
+
+class DisjointSet {
+    private:
+        std::vector<int> parent,
+                         size;
+
+    public:
+        /**
+            Description:   Initializes a DisjointSet where every element is in
+                           its own set.
+            Return:        None
+            Precondition:  None
+            Postcondition: A DisjointSet with the provided number of elements
+                           is returned.
+        */
+        DisjointSet(int);
+
+        /**
+            Description:   Finds the representative element of the set that
+                           contains the provided element. Paths are shortened
+                           along the way, without recursion.
+            Return:        int
+            Precondition:  The element is within the set.
+            Postcondition: The representative element is returned.
+        */
+        int find(int);
+
+        /**
+            Description:   Merges the sets containing the two elements. The
+                           smaller set is attached to the larger one.
+            Return:        void
+            Precondition:  Both elements are within the set.
+            Postcondition: Both elements will share a representative.
+        */
+        void unite(int, int);
+};
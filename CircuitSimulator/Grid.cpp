@@ -1,133 +1,214 @@
 /**
     Author:             Matthew Olsson
     File Title:         Grid.h
-    File Description:   Implements the Grid class. This class is responsible 
-                        for maintaining and storing the components and 
-                        GridSpots. All Components and GridSpots are stored as 
-                        pointers so they can be passed around and manipulated 
+    File Description:   Implements the Grid class. This class is responsible
+                        for maintaining and storing the components and
+                        GridSpots. All Components and GridSpots are stored as
+                        pointers so they can be passed around and manipulated
                         by other classes.
     Due Date:           4/25/2018
     Date Created:       3/24/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
+#include <algorithm>      // min, max, find
+#include <cmath>          // round, floor
 #include "Grid.h"
 #include "Config.h"
 
-Grid::Grid(int appWidth, int appHeight) {
+namespace {
+    // How close the mouse must be to a component to be over it, in pixels
+    const double HIT_DISTANCE = 14.0;
+
+    // The width and height of a bucket of the component index, in lattice
+    // points, and the most buckets a component is stored in. Small buckets
+    // keep the number of components checked per search low; a horizontal or
+    // vertical component up to 500 points long still fits.
+    const int BUCKET_SIZE = 2;
+    const int MAX_BUCKETS = 256;
+
+    /**
+        Description:   Returns the bucket a lattice coordinate falls in.
+        Return:        int
+        Precondition:  None
+        Postcondition: The coordinate divided by BUCKET_SIZE, rounded down
+                       (also for negative coordinates), is returned.
+    */
+    int getBucket(double coordinate) {
+        return int(floor(coordinate / BUCKET_SIZE));
+    }
+
+    /**
+        Description:   Returns the squared distance from a point to the line
+                       segment between two others.
+        Return:        double
+        Precondition:  None
+        Postcondition: The squared distance is returned.
+    */
+    double getSegmentDistance2(double px, double py, double ax, double ay, double bx, double by) {
+        double dx = bx - ax,
+               dy = by - ay,
+               length2 = dx * dx + dy * dy;
+
+        // The fraction of the way along the segment of its closest point
+        double t = length2 == 0.0 ? 0.0 : ((px - ax) * dx + (py - ay) * dy) / length2;
+        t = std::min(std::max(t, 0.0), 1.0);
+
+        double ex = ax + t * dx - px,
+               ey = ay + t * dy - py;
+
+        return ex * ex + ey * ey;
+    }
+}
+
+Grid::Grid(int appWidth, int appHeight) : spacing(float(SPOT_SPACING)) {
+    resize(appWidth, appHeight);
+}
+
+void Grid::resize(int appWidth, int appHeight) {
+    left = GRID_LEFT_OFFSET;
+    top = GRID_TOP_OFFSET;
 	width = appWidth - GRID_LEFT_OFFSET - GRID_RIGHT_OFFSET;
 	height = appHeight - GRID_TOP_OFFSET - GRID_BOTTOM_OFFSET;
+}
 
-    // Calculate total number of spots in each direction
-    numSpotsHorz = width / SPOT_SPACING;
-    numSpotsVert = height / SPOT_SPACING;
-
-    // Calculate the padding requires to center the GridSpots in the middle
-    // of the grid
-    paddingHorz = (width - (numSpotsHorz - 1) * SPOT_SPACING) / 2;
-    paddingVert = (height - (numSpotsVert - 1) * SPOT_SPACING) / 2;
-
-    // Keep track of x/y position for iterating
-    int currX = GRID_LEFT_OFFSET + paddingHorz;
-    int currY = GRID_TOP_OFFSET + paddingVert;
-
-    // Initialize spots vector
-    spots = std::vector<std::vector<GridSpot*>>(numSpotsVert, std::vector<GridSpot*>(numSpotsHorz));
-
-    // Iterate and populate the spots vector with GridSpot pointers
-    for (int i = 0; i < numSpotsVert; i++, currY += SPOT_SPACING) {
-        std::vector<GridSpot*> row = std::vector<GridSpot*>(numSpotsHorz);
-        for (int j = 0; j < numSpotsHorz; j++, currX += SPOT_SPACING) 
-            row[j] = new GridSpot(currX, currY);
-        spots[i] = row;
-        currX = GRID_LEFT_OFFSET + paddingHorz;
-    }
+void Grid::pan(sf::Vector2f distance) {
+    origin -= distance / spacing;
+}
+
+void Grid::zoom(float factor, sf::Vector2i about) {
+    // The lattice position under the point, which should stay there
+    sf::Vector2f offset(float(about.x - left), float(about.y - top));
+    sf::Vector2f position = origin + offset / spacing;
+
+    spacing = std::min(std::max(spacing * factor, MIN_SPOT_SPACING), MAX_SPOT_SPACING);
+    origin = position - offset / spacing;
+}
+
+sf::FloatRect Grid::getArea() const {
+    return sf::FloatRect(float(left), float(top), float(width), float(height));
 }
 
-std::vector<Component*> Grid::getComponents() const {
+sf::Vector2f Grid::toScreen(sf::Vector2i point) const {
+    return { float(left) + (float(point.x) - origin.x) * spacing,
+             float(top) + (float(point.y) - origin.y) * spacing };
+}
+
+sf::Vector2f Grid::toScreen(const GridSpot* spot) const {
+    return toScreen(sf::Vector2i(spot->x, spot->y));
+}
+
+sf::Transform Grid::getTransform() const {
+    sf::Transform transform;
+    transform.translate(float(left) - origin.x * spacing, float(top) - origin.y * spacing);
+    transform.scale(spacing, spacing);
+
+    return transform;
+}
+
+const std::vector<Component*>& Grid::getComponents() const {
     return components;
 };
 
-std::vector<std::vector<GridSpot*>> Grid::getSpots() const {
+const spot_vec& Grid::getSpots() const {
     return spots;
 };
 
-bool Grid::getNearestSpot(sf::Vector2i mousePos, GridSpot*& spot) const {
+bool Grid::getNearestPoint(sf::Vector2i mousePos, sf::Vector2i& point) const {
     // Localize the x and y coordinates within the grid
-    int x = mousePos.x - GRID_LEFT_OFFSET - paddingHorz;
-    int y = mousePos.y - GRID_TOP_OFFSET - paddingVert;
+    int x = mousePos.x - left;
+    int y = mousePos.y - top;
+
+    // Ensure the mouse is within the grid bounds
+    if (x < 0 || y < 0 || x > width || y > height)
+        return false;
 
-    // Calculate the x and y index within the spots array of the closest spot
-    // to the mouse positions
-    int xIndex = (int) round(double(x) / double(SPOT_SPACING));
-    int yIndex = (int) round(double(y) / double(SPOT_SPACING));
-    
-    // Ensure indices are not out of the grid bounds
-    bool invalid = xIndex < 0 || yIndex < 0 || xIndex > numSpotsHorz - 1 || yIndex > numSpotsVert - 1;
-    if (!invalid)
-        spot = spots[yIndex][xIndex];
+    // Calculate the lattice point closest to the mouse position
+    point.x = (int) round(double(origin.x) + double(x) / double(spacing));
+    point.y = (int) round(double(origin.y) + double(y) / double(spacing));
 
-    return !invalid;
+    return true;
 }
 
 bool Grid::getComponentUnderPosition(sf::Vector2i pos, Component*& nearestComp) const {
-    double x,
-        y,
-        dx,
-        dy;
-    GridSpot* spot1;
-    GridSpot* spot2;
-    Component* component;
-
-    // Iterate through all components and check if the mouse position is within
-    // 14 pixels of that component
-    for (int i = 0; i < components.size(); i++) {
-        component = components.at(i);
-
-        spot1 = component->positive;
-        spot2 = component->negative;
-
-        x = double(spot1->x);
-        y = double(spot1->y);
-
-        dx = (spot2->x - x) / 30.0;
-        dy = (spot2->y - y) / 30.0;
-
-        // Loop along the line that the component forms
-        for (int j = 0; j < 40; j++) {
-            if (fabs(x - double(pos.x)) < 14.0 && fabs(y - double(pos.y)) < 14.0) {
-                // The mouse is within 14 pixels of this component
-                nearestComp = component;
-                return true;
-            }
+    // Work in lattice units, where the mouse must be within radius of a
+    // component
+    double x = double(origin.x) + double(pos.x - left) / double(spacing),
+           y = double(origin.y) + double(pos.y - top) / double(spacing),
+           radius = HIT_DISTANCE / double(spacing),
+           nearest = radius * radius;
+    Component* found = nullptr;
+
+    auto check = [&](Component* component) {
+        double distance = getSegmentDistance2(x, y,
+                                              component->positive->x, component->positive->y,
+                                              component->negative->x, component->negative->y);
 
-            x += dx;
-            y += dy;
+        if (distance <= nearest) {
+            nearest = distance;
+            found = component;
+        }
+    };
+
+    // Any component within the radius overlaps one of the buckets around the
+    // mouse
+    for (int row = getBucket(y - radius); row <= getBucket(y + radius); row++) {
+        for (int column = getBucket(x - radius); column <= getBucket(x + radius); column++) {
+            auto bucket = buckets.find(getKey(column, row));
+            if (bucket == buckets.end())
+                continue;
+
+            for (Component* component : bucket->second)
+                check(component);
         }
     }
 
-    return false;
+    for (Component* component : longComponents)
+        check(component);
+
+    if (found == nullptr)
+        return false;
+
+    nearestComp = found;
+    return true;
 }
 
 void Grid::clearComponents() {
     components.clear();
+    owned.clear();
 
-    // Clear all component references from the GridSpots
-    for (std::vector<GridSpot*> row : spots) {
-        for (GridSpot* spot : row) {
-            spot->components.clear();
-        }
-    }
+    // No spot is occupied anymore
+    spots[0].clear();
+    spotIndices.clear();
+    storage.clear();
+    freeSpots.clear();
+    buckets.clear();
+    longComponents.clear();
+}
+
+void Grid::reserve(std::size_t componentCount, std::size_t spotCount) {
+    components.reserve(componentCount);
+    owned.reserve(componentCount);
+    spots[0].reserve(spotCount);
+    spotIndices.reserve(spotCount);
 }
 
-void Grid::addComponent(Component* component) {
+void Grid::addComponent(Component* component, sf::Vector2i positive, sf::Vector2i negative) {
+    component->positive = acquireSpot(positive);
+    component->negative = acquireSpot(negative);
+    component->positive->components.push_back(component);
+    component->negative->components.push_back(component);
+
 	components.push_back(component);
+    owned.emplace_back(component);
+    indexComponent(component);
 }
 
 void Grid::removeComponent(Component* component) {
-    std::vector<Component*>::iterator it = components.begin();
     bool deleted;
 
+    unindexComponent(component);
+
     // Removed the component from both spots
     for (GridSpot* spot : { component->positive, component->negative }) {
         deleted = false;
@@ -142,14 +223,124 @@ void Grid::removeComponent(Component* component) {
         }
     }
 
-    // Remove the component from the components array
-    deleted = false;
-    while (!deleted && it != components.end()) {
-        if (*it == component) {
-            components.erase(it);
-            deleted = true;
-        } else {
-            ++it;
+    // Free the spots if nothing else is connected to them
+    releaseSpot(component->positive);
+    if (component->negative != component->positive)
+        releaseSpot(component->negative);
+
+    // Remove the component from the components array, and delete it
+    auto found = std::find(components.begin(), components.end(), component);
+    if (found != components.end()) {
+        std::size_t index = std::size_t(found - components.begin());
+
+        components.erase(found);
+        owned.erase(owned.begin() + index);
+    }
+}
+
+long long Grid::getKey(int x, int y) {
+    return (long long)(unsigned(x)) << 32 | (long long)(unsigned(y));
+}
+
+GridSpot* Grid::acquireSpot(sf::Vector2i point) {
+    long long key = getKey(point.x, point.y);
+
+    auto found = spotIndices.find(key);
+    if (found != spotIndices.end())
+        return spots[0][found->second];
+
+    // Reuse a freed spot if there is one
+    GridSpot* spot;
+    if (!freeSpots.empty()) {
+        spot = freeSpots.back();
+        freeSpots.pop_back();
+        spot->x = point.x;
+        spot->y = point.y;
+        spot->node = -1;
+    } else {
+        storage.emplace_back(point.x, point.y);
+        spot = &storage.back();
+    }
+
+    spotIndices[key] = int(spots[0].size());
+    spots[0].push_back(spot);
+
+    return spot;
+}
+
+bool Grid::getBucketRange(const Component* component, sf::Vector2i& first, sf::Vector2i& last) const {
+    first.x = getBucket(std::min(component->positive->x, component->negative->x));
+    first.y = getBucket(std::min(component->positive->y, component->negative->y));
+    last.x = getBucket(std::max(component->positive->x, component->negative->x));
+    last.y = getBucket(std::max(component->positive->y, component->negative->y));
+
+    return (long long)(last.x - first.x + 1) * (last.y - first.y + 1) <= MAX_BUCKETS;
+}
+
+void Grid::indexComponent(Component* component) {
+    sf::Vector2i first,
+                 last;
+
+    if (!getBucketRange(component, first, last)) {
+        longComponents.push_back(component);
+        return;
+    }
+
+    for (int row = first.y; row <= last.y; row++) {
+        for (int column = first.x; column <= last.x; column++)
+            buckets[getKey(column, row)].push_back(component);
+    }
+}
+
+void Grid::unindexComponent(Component* component) {
+    sf::Vector2i first,
+                 last;
+
+    // Components are removed by swapping them with the last component of
+    // their list, since the order within a bucket does not matter
+    auto remove = [component](std::vector<Component*>& list) {
+        auto found = std::find(list.begin(), list.end(), component);
+        if (found != list.end()) {
+            *found = list.back();
+            list.pop_back();
+        }
+    };
+
+    if (!getBucketRange(component, first, last)) {
+        remove(longComponents);
+        return;
+    }
+
+    for (int row = first.y; row <= last.y; row++) {
+        for (int column = first.x; column <= last.x; column++) {
+            auto bucket = buckets.find(getKey(column, row));
+            if (bucket == buckets.end())
+                continue;
+
+            remove(bucket->second);
+            if (bucket->second.empty())
+                buckets.erase(bucket);
         }
     }
+}
+
+void Grid::releaseSpot(GridSpot* spot) {
+    if (!spot->components.empty())
+        return;
+
+    // The spot may already have been released
+    auto found = spotIndices.find(getKey(spot->x, spot->y));
+    if (found == spotIndices.end() || spots[0][found->second] != spot)
+        return;
+
+    // Move the last spot into this one's place, so the row stays packed
+    int index = found->second;
+    GridSpot* last = spots[0].back();
+
+    spots[0][index] = last;
+    spotIndices[getKey(last->x, last->y)] = index;
+    spots[0].pop_back();
+    spotIndices.erase(found);
+
+    freeSpots.push_back(spot);
 }
\ No newline at end of file
@@ -5,96 +5,270 @@
                         maintaining and storing the components and GridSpots.
                         All Components and GridSpots are stored as pointers
                         so they can be passed around and manipulated by other
-                        classes.
+                        classes. The grid is an unbounded lattice, and only
+                        the lattice points that a component is connected to
+                        have a GridSpot. The part of the lattice that is shown
+                        on screen is set by a viewport that can be panned and
+                        zoomed. Components are indexed by the square buckets
+                        of the lattice they cross, so finding the component
+                        under the mouse only looks at nearby components.
     Due Date:           4/25/2018
     Date Created:       3/24/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
 
+#include <deque>              // deque class
+#include <memory>             // unique_ptr class
+#include <unordered_map>      // unordered_map class
 #include <vector>             // vector class, .push_back(), .at(), .clear(),
                               // .erase(), .begin(), .end()
-#include <SFML/Graphics.hpp>  // Objects: Vector2i/f, .x, .y
+#include <SFML/Graphics.hpp>  // Objects: Vector2i/f, FloatRect, Transform,
+                              // .x, .y
 #include "Component.h"
 #include "GridSpot.h"
 
-class Grid { 
+class Grid {
 	private:
-        int width,
-            height,
-            numSpotsHorz,
-            numSpotsVert,
-            paddingHorz,
-            paddingVert;
+        // The area of the window the grid is drawn in, in pixels
+        int left = 0,
+            top = 0,
+            width = 0,
+            height = 0;
+
+        // The lattice position shown at the top left corner of the grid
+        // area, and the number of pixels between neighbouring lattice points
+        sf::Vector2f origin = { -0.5f, -0.5f };
+        float spacing = 0.0f;
 
 		std::vector<Component*> components;
-		std::vector<std::vector<GridSpot*>> spots;
+
+        // The grid owns its components. Each is kept at the same index as in
+        // components.
+        std::vector<std::unique_ptr<Component>> owned;
+
+        // Every occupied spot, as a single row (like Circuit's spots)
+		spot_vec spots = spot_vec(1);
+
+        // The index in spots[0] of the spot at each lattice point, keyed by
+        // getKey()
+        std::unordered_map<long long, int> spotIndices;
+
+        // Every GridSpot, including those that are no longer occupied. A
+        // deque never moves its elements, so the spots can be pointed to.
+        // Unoccupied spots are reused before the deque grows.
+        std::deque<GridSpot> storage;
+        std::vector<GridSpot*> freeSpots;
+
+        // The components whose bounding box overlaps each bucket of the
+        // lattice, keyed by getKey() of the bucket's column and row.
+        // Components that would be in too many buckets are kept in
+        // longComponents instead, and are always checked.
+        std::unordered_map<long long, std::vector<Component*>> buckets;
+        std::vector<Component*> longComponents;
+
+        /**
+            Description:   Returns the key of a lattice point in spotIndices.
+            Return:        long long
+            Precondition:  None
+            Postcondition: A key unique to the lattice point is returned.
+        */
+        static long long getKey(int, int);
+
+        /**
+            Description:   Returns the spot at a lattice point, creating it if
+                           the point is not occupied yet.
+            Return:        GridSpot*
+            Precondition:  This object exists.
+            Postcondition: The spot at the lattice point is returned.
+        */
+        GridSpot* acquireSpot(sf::Vector2i);
+
+        /**
+            Description:   Frees a spot if no components are connected to it.
+            Return:        void
+            Precondition:  The spot belongs to this Grid.
+            Postcondition: If the spot is unoccupied, it will have been removed
+                           from the spots vector and kept for reuse.
+        */
+        void releaseSpot(GridSpot*);
+
+        /**
+            Description:   Finds the range of buckets a component's bounding
+                           box overlaps.
+            Return:        bool
+            Precondition:  The component is connected to two spots.
+            Postcondition: The first and last bucket columns (x) and rows (y)
+                           are set. Returns false if the component overlaps
+                           too many buckets to be stored in them.
+        */
+        bool getBucketRange(const Component*, sf::Vector2i&, sf::Vector2i&) const;
+
+        /**
+            Description:   Adds a component to the buckets it overlaps.
+            Return:        void
+            Precondition:  The component is connected to two spots, and is not
+                           indexed yet.
+            Postcondition: The component will be found by
+                           getComponentUnderPosition().
+        */
+        void indexComponent(Component*);
+
+        /**
+            Description:   Removes a component from the buckets it overlaps.
+            Return:        void
+            Precondition:  The component was indexed, and has not moved since.
+            Postcondition: The component will no longer be found by
+                           getComponentUnderPosition(). Empty buckets are
+                           removed.
+        */
+        void unindexComponent(Component*);
 
 	public:
         /**
-            Description:   Initializes a Grid object.
+            Description:   Initializes an empty Grid object with no area.
             Return:        None
             Precondition:  None
-            Postcondition: A Grid object will be initialized. width and height
-                           will be set to the size specified in Config.cpp,
-                           and the spots array will be filled with enough spots
-                           to fill the grid dimensions.
+            Postcondition: A Grid object with no components or spots will be
+                           initialized. Its area is empty until resize() is
+                           called.
         */
         Grid() = default;
 
         /**
-            Description:   Initializes a Grid object with the provided width
-                           and height.
+            Description:   Initializes an empty Grid object drawn in a window
+                           of the provided width and height.
             Return:        None
             Precondition:  None
-            Postcondition: A Grid object will be initialized. width and height
-                           will be set to the size specified in Config.cpp,
-                           and the spots array will be filled with enough spots
-                           to fill the grid dimensions.
+            Postcondition: A Grid object will be initialized. Its area will be
+                           the window minus the offsets specified in
+                           Config.cpp, and it will be zoomed to SPOT_SPACING.
         */
 		Grid(int, int);
 
+        // The spots are pointed to by the components, so a Grid can be moved
+        // but not copied
+        Grid(const Grid&) = delete;
+        Grid& operator =(const Grid&) = delete;
+        Grid(Grid&&) = default;
+        Grid& operator =(Grid&&) = default;
+
         /**
-            Description:   Returns the components vector.
-            Return:        vector<Component*>
+            Description:   Fits the grid area to a window of the provided width
+                           and height.
+            Return:        void
             Precondition:  This object exists.
-            Postcondition: The components array will be returned. This object
+            Postcondition: The grid area will be updated. The spots and
+                           components are not affected.
+        */
+        void resize(int, int);
+
+        /**
+            Description:   Moves the viewport by a distance in pixels.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: The lattice will appear to have moved by the
+                           distance.
+        */
+        void pan(sf::Vector2f);
+
+        /**
+            Description:   Zooms the viewport in (factor above one) or out
+                           (factor below one), keeping the lattice position
+                           under a point in the window still.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: The spacing between lattice points will have been
+                           multiplied by the factor, within the limits set in
+                           Config.cpp.
+        */
+        void zoom(float, sf::Vector2i);
+
+        /**
+            Description:   Returns the area of the window the grid is drawn in.
+            Return:        FloatRect
+            Precondition:  This object exists.
+            Postcondition: The area is returned, in pixels. This object will
+                           not be modified.
+        */
+        sf::FloatRect getArea() const;
+
+        /**
+            Description:   Returns where a lattice point is drawn in the
+                           window.
+            Return:        Vector2f
+            Precondition:  This object exists.
+            Postcondition: The position is returned, in pixels. It may be
+                           outside the grid area. This object will not be
+                           modified.
+        */
+        sf::Vector2f toScreen(sf::Vector2i) const;
+
+        /**
+            Description:   Returns where a spot is drawn in the window.
+            Return:        Vector2f
+            Precondition:  This object exists, and the spot is valid.
+            Postcondition: The position is returned, in pixels. This object
                            will not be modified.
         */
-		std::vector<Component*> getComponents() const;
+        sf::Vector2f toScreen(const GridSpot*) const;
 
         /**
-            Description:   Returns the spots vector
-            Return:        vector<vector<GridSpot*>>
+            Description:   Returns the transform from lattice coordinates to
+                           the window.
+            Return:        Transform
             Precondition:  This object exists.
-            Postcondition: The spots array will be returned. This object will
+            Postcondition: A transform that maps each lattice point to where
+                           toScreen() puts it is returned. This object will
                            not be modified.
         */
-		std::vector<std::vector<GridSpot*>> getSpots() const;
+        sf::Transform getTransform() const;
+
+        /**
+            Description:   Returns the components vector.
+            Return:        vector<Component*>
+            Precondition:  This object exists.
+            Postcondition: The components array will be returned without being
+                           copied. It stays valid until a component is added
+                           or removed. This object will not be modified.
+        */
+		const std::vector<Component*>& getComponents() const;
 
         /**
-            Description:   Gets the nearest spot to the mouse cursor. 
+            Description:   Returns the occupied spots.
+            Return:        spot_vec
+            Precondition:  This object exists.
+            Postcondition: Every spot with a component connected to it is
+                           returned as a single row, without being copied. This
+                           object will not be modified.
+        */
+		const spot_vec& getSpots() const;
+
+        /**
+            Description:   Gets the nearest lattice point to the mouse cursor.
             Return:        bool
-            Precondition:  This object exists, and the GridSpot passed in is a 
-                           valid GridSpot pointer reference.
-            Postcondition: If the mouse is within the grid area, the spot
-                           argument will be set to the closest spot, and the
-                           function will return true. Else, spot will be 
-                           unmodified. Neither this object nor mousePos will be
-                           modified.
+            Precondition:  This object exists.
+            Postcondition: If the mouse is within the grid area, the point
+                           argument will be set to the closest lattice point,
+                           and the function will return true. Else, the point
+                           will be unmodified. Neither this object nor
+                           mousePos will be modified.
         */
-        bool getNearestSpot(sf::Vector2i, GridSpot*&) const;
+        bool getNearestPoint(sf::Vector2i, sf::Vector2i&) const;
 
         /**
             Description:   Gets the component under the mouse cursor. Searches
-                           for components within 14 pixels of the cursor.
+                           for components within 14 pixels of the cursor,
+                           measured to the nearest point of each component's
+                           line. Only the buckets around the cursor are
+                           searched.
             Return:        bool
             Precondition:  This object exists, and the Component passed in is a
                            valid Component pointer reference.
             Postcondition: If a component is within 14 pixels of the mouse
-                           cursor, the component pointer will be set to that
-                           component and the function will return true. Else,
+                           cursor, the component pointer will be set to the
+                           closest one and the function will return true. Else,
                            the function will return false, and the component
                            pointer will not be modified. Neither this object
                            nor the vector will be modified.
@@ -102,35 +276,50 @@ class Grid {
         bool getComponentUnderPosition(sf::Vector2i, Component*&) const;
 
         /**
-            Description:   Clears the components vector. Additionally, loops 
-                           through the spots vector and removes all component
-                           references.
+            Description:   Deletes every component. Additionally, frees every
+                           spot, as none of them are occupied anymore.
             Return:        void
             Precondition:  This object exists.
-            Postcondition: The components vector will be cleared, and all
-                           GridSpots will have any component references 
-                           cleared.
+            Postcondition: The components vector will be cleared, and there
+                           will be no spots. Pointers to the components and
+                           spots are no longer valid.
         */
         void clearComponents();
 
         /**
-            Description:   Adds a component to the components vector.
+            Description:   Prepares the grid to hold a number of components
+                           and spots without growing its indices.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: Adding up to the provided number of components and
+                           spots will not rehash or reallocate the indices.
+        */
+        void reserve(std::size_t, std::size_t);
+
+        /**
+            Description:   Adds a component between two lattice points.
             Return:        void
             Precondition:  This object exists, and the component pointer passed
-                           in has been properly initialized.
-            Postcondition: A component will be added to the component vector.
-                           The component will not be modified.
+                           in has been properly initialized with new.
+            Postcondition: A component will be added to the component vector,
+                           and connected to the spots at the two points (its
+                           positive end first). The spots are created if the
+                           points were not occupied. The grid takes ownership
+                           of the component.
         */
-		void addComponent(Component*);
+		void addComponent(Component*, sf::Vector2i, sf::Vector2i);
 
         /**
             Description:   Removes the component from the components vector
-                           as well as from both the spots it was connected to.
+                           as well as from both the spots it was connected to,
+                           and deletes it.
             Return:        void
-            Precondition:  This object exists.
+            Precondition:  This object exists, and the component belongs to
+                           it.
             Postcondition: The component will have been removed from both
                            the components array and from the GridSpots it was
-                           connected to.
+                           connected to. Spots left unoccupied are freed. The
+                           component pointer is no longer valid.
         */
         void removeComponent(Component*);
-};
+};
\ No newline at end of file
@@ -7,36 +7,35 @@
                         connected to other components.
     Due Date:           4/25/2018
     Date Created:       3/24/2018
-    Date Last Modified: 4/23/2018
+    Date Last Modified: 10/18/2026
 */
 
 #pragma once
 
 #include <vector>                   // Vector class
-#include <SFML/System/Vector2.hpp>  // sf::Vector2f
 #include "Component.h"
 
 struct GridSpot {
-    const int x,
-              y;
+    // The lattice point of the spot. The Grid converts it to a position on
+    // screen, and reuses spots at new points once they are unoccupied.
+    int x,
+        y;
 
     std::vector<Component*> components;
 
+    // The id of the node this spot belongs to, as assigned the last time
+    // the circuit was analyzed (see Calculator::buildSystem()), or -1 if it
+    // never has been. Keeping it here lets a component's nodes be read
+    // straight from its spots.
+    int node;
+
     /**
         Description:   Initializes a Grid with the provided coordinates.
         Return:        None
         Precondition:  None
         Postcondition: Returns a Grid object with the provided coordinates.
     */
-    inline GridSpot(int x, int y) : x(x), y(y) { };
+    inline GridSpot(int x, int y) : x(x), y(y), node(-1) { };
+};
 
-    /**
-        Description:   Returns the coordinates in as a float vector.
-        Return:        sf::Vector2f
-        Precondition:  This object exists.
-        Postcondition: A vector of the coordinate is returned.
-    */
-    inline sf::Vector2f getVector() const { 
-        return sf::Vector2f{ float(x), float(y) }; 
-    }
-};
\ No newline at end of file
+typedef std::vector<std::vector<GridSpot*>> spot_vec;
\ No newline at end of file
@@ -0,0 +1,421 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         MonteCarlo.cpp
+    File Description:   Implements the MonteCarlo class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // min, max
+#include <atomic>         // atomic class
+#include <cmath>          // sqrt, floor, ldexp, ilogb, isfinite
+#include <exception>      // exception_ptr, current_exception, rethrow_exception
+#include <limits>         // numeric_limits
+#include <mutex>          // mutex, lock_guard
+#include <random>         // mt19937_64, uniform_real_distribution, normal_distribution
+#include <stdexcept>      // runtime_error
+#include <thread>         // thread class
+#include <utility>        // move, pair
+#include "MonteCarlo.h"
+
+namespace {
+    /**
+        Description:   Computes the seed of a block's random number stream
+                       with the splitmix64 mixing function, so that
+                       neighbouring blocks get unrelated streams.
+        Return:        uint64_t
+        Precondition:  None
+        Postcondition: The seed is returned.
+    */
+    std::uint64_t getBlockSeed(std::uint64_t seed, long long block) {
+        std::uint64_t z = seed + (std::uint64_t(block) + 1) * 0x9E3779B97F4A7C15ull;
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+        return z ^ (z >> 31);
+    }
+
+    /**
+        Description:   Finds the smallest exponent whose bins can hold the
+                       sample, so that its bin number fits in a long long.
+        Return:        int
+        Precondition:  The sample is finite.
+        Postcondition: The exponent is returned.
+    */
+    int getMinExponent(double sample) {
+        if (sample == 0.0)
+            return std::numeric_limits<double>::min_exponent - std::numeric_limits<double>::digits;
+
+        return std::ilogb(sample) - (std::numeric_limits<double>::digits - 1);
+    }
+
+    /**
+        Description:   Returns the number of the bin, 2^exponent wide, that
+                       the sample falls in.
+        Return:        long long
+        Precondition:  The exponent is at least getMinExponent(sample).
+        Postcondition: The bin is returned. Scaling by a power of two is
+                       exact, so no sample is counted in a neighbouring bin.
+    */
+    long long getBin(double sample, int exponent) {
+        return (long long)std::floor(std::ldexp(sample, -exponent));
+    }
+
+    /**
+        Description:   Returns the bin that a bin falls in once the bins are
+                       made 2^shift times wider.
+        Return:        long long
+        Precondition:  The shift is not negative.
+        Postcondition: The bin divided by 2^shift, rounded down, is
+                       returned.
+    */
+    long long shiftBin(long long bin, int shift) {
+        if (shift >= std::numeric_limits<long long>::digits)
+            return bin < 0 ? -1 : 0;
+
+        return bin >= 0 ? bin >> shift : -((-(bin + 1)) >> shift) - 1;
+    }
+
+    /**
+        Description:   Runs the worker on the provided number of threads,
+                       including the calling thread, and waits for every
+                       thread to finish.
+        Return:        void
+        Precondition:  The number of threads is positive.
+        Postcondition: Every thread will have finished. Rethrows the first
+                       exception thrown by a worker.
+    */
+    void runParallel(int threads, const std::function<void()>& worker) {
+        std::mutex mutex;
+        std::exception_ptr error;
+
+        auto run = [&]() {
+            try {
+                worker();
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(mutex);
+                if (!error)
+                    error = std::current_exception();
+            }
+        };
+
+        std::vector<std::thread> pool;
+        for (int t = 1; t < threads; t++)
+            pool.emplace_back(run);
+
+        run();
+
+        for (std::thread& thread : pool)
+            thread.join();
+
+        if (error)
+            std::rethrow_exception(error);
+    }
+}
+
+void MonteCarlo::Moments::add(double sample) {
+    count++;
+
+    if (count == 1) {
+        min = max = sample;
+    } else {
+        min = std::min(min, sample);
+        max = std::max(max, sample);
+    }
+
+    // Welford's update, which stays accurate when the spread is small
+    // compared to the mean
+    double delta = sample - mean;
+    mean += delta / count;
+    m2 += delta * (sample - mean);
+}
+
+void MonteCarlo::Moments::merge(const Moments& other) {
+    if (other.count == 0)
+        return;
+
+    if (count == 0) {
+        *this = other;
+        return;
+    }
+
+    long long total = count + other.count;
+    double delta = other.mean - mean;
+
+    mean += delta * other.count / total;
+    m2 += other.m2 + delta * delta * (double(count) * other.count / total);
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+    count = total;
+}
+
+void MonteCarlo::Histogram::add(double sample, int bins) {
+    // A NaN or infinite result has no bin. It is still reflected in the
+    // moments.
+    if (!std::isfinite(sample))
+        return;
+
+    int minExponent = getMinExponent(sample);
+
+    if (counts.empty()) {
+        exponent = minExponent;
+        first = getBin(sample, exponent);
+        counts.assign(1, 1);
+        return;
+    }
+
+    int wide = std::max(exponent, minExponent);
+    long long bin = getBin(sample, wide);
+
+    if (wide != exponent || bin < first || bin >= first + (long long)counts.size())
+        widen(wide, bin, bin, bins);
+
+    counts[shiftBin(bin, exponent - wide) - first]++;
+}
+
+void MonteCarlo::Histogram::merge(const Histogram& other, int bins) {
+    if (other.counts.empty())
+        return;
+
+    if (counts.empty()) {
+        *this = other;
+        return;
+    }
+
+    widen(other.exponent, other.first, other.first + (long long)other.counts.size() - 1, bins);
+
+    for (int k = 0; k < int(other.counts.size()); k++)
+        counts[shiftBin(other.first + k, exponent - other.exponent) - first] += other.counts[k];
+}
+
+void MonteCarlo::Histogram::widen(int exponent_, long long lo, long long hi, int bins) {
+    // Find the range of both sets of bins at the wider of the two widths,
+    // then double the width until the range fits
+    int wide = std::max(exponent, exponent_);
+    long long last = first + (long long)counts.size() - 1,
+              start = std::min(shiftBin(first, wide - exponent), shiftBin(lo, wide - exponent_)),
+              end = std::max(shiftBin(last, wide - exponent), shiftBin(hi, wide - exponent_));
+
+    while (end - start + 1 > bins) {
+        wide++;
+        start = shiftBin(start, 1);
+        end = shiftBin(end, 1);
+    }
+
+    if (wide == exponent && start == first && end == last)
+        return;
+
+    std::vector<long long> widened(end - start + 1, 0);
+
+    for (int k = 0; k < int(counts.size()); k++)
+        widened[shiftBin(first + k, wide - exponent) - start] += counts[k];
+
+    exponent = wide;
+    first = start;
+    counts.swap(widened);
+}
+
+MonteCarlo::MonteCarlo(const Circuit& circuit, const Tolerance& tolerance,
+                       const std::map<std::string, Tolerance>& overrides) : system(circuit) {
+    const std::vector<Component*>& components = circuit.getComponents();
+
+    for (int i = 0; i < int(components.size()); i++) {
+        if (components[i]->type == &WIRE)
+            continue;
+
+        names.push_back(circuit.getName(i));
+        tolerances.push_back(tolerance);
+        system.addComponent(circuit, i);
+    }
+
+    for (const auto& entry : overrides) {
+        auto found = std::find(names.begin(), names.end(), entry.first);
+
+        if (found == names.end())
+            throw std::runtime_error("There is no resistor or voltage source named " + entry.first);
+
+        tolerances[found - names.begin()] = entry.second;
+    }
+
+    for (int i = 0; i < int(names.size()); i++) {
+        if (tolerances[i].spread != 0.0 && !system.canVary(i))
+            throw std::runtime_error(names[i] + " is in parallel with resistors too large "
+                                     "to vary");
+    }
+}
+
+long long MonteCarlo::runBlock(long long block, long long trials, std::uint64_t seed,
+                               ParametricSystem::Workspace& workspace, std::vector<double>& values,
+                               std::vector<double>& voltages, std::vector<double>& currents,
+                               const std::function<void()>& callback) const {
+    const int n = system.getComponentCount();
+    long long first = block * BLOCK_SIZE,
+              last = std::min(trials, first + BLOCK_SIZE),
+              failed = 0;
+
+    std::mt19937_64 random(getBlockSeed(seed, block));
+    std::uniform_real_distribution<double> uniform(-1.0, 1.0);
+    std::normal_distribution<double> normal(0.0, 1.0);
+
+    values.resize(n);
+    voltages.resize(n);
+    currents.resize(n);
+
+    for (long long t = first; t < last; t++) {
+        // Every component draws from the stream, even with no spread, so a
+        // trial's values only depend on the seed and the trial's index
+        for (int i = 0; i < n; i++) {
+            const Tolerance& tolerance = tolerances[i];
+            double deviation = tolerance.distribution == Tolerance::UNIFORM ? uniform(random)
+                                                                            : normal(random);
+
+            values[i] = system.getValue(i) * (1.0 + tolerance.spread * deviation);
+        }
+
+        if (!system.solve(values, workspace)) {
+            failed++;
+            continue;
+        }
+
+        for (int i = 0; i < n; i++)
+            system.getResult(workspace, i, values[i], voltages[i], currents[i]);
+
+        callback();
+    }
+
+    return failed;
+}
+
+MonteCarloResult MonteCarlo::run(long long trials, std::uint64_t seed, int threads, int bins) const {
+    if (threads <= 0)
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    // Zero is always a bin edge, so samples of both signs need two bins
+    if (bins == 1)
+        bins = 2;
+
+    const int n = system.getComponentCount();
+    const long long blockCount = (trials + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    MonteCarloResult result;
+    result.trials = trials;
+
+    // The sums behind the moments depend on the order they are added in, so
+    // blocks are merged in order no matter which thread finishes first.
+    // Histograms are merged exactly in any order, so each thread counts
+    // every trial it solves into its own. The voltage of component i is
+    // quantity 2i, and its current 2i + 1.
+    std::vector<Moments> totals(2 * n);
+    std::vector<Histogram> histograms(bins > 0 ? 2 * n : 0);
+    std::atomic<long long> next(0);
+    std::mutex mutex;
+    std::map<long long, std::pair<long long, std::vector<Moments>>> finished;
+    long long nextToMerge = 0;
+
+    runParallel(threads, [&]() {
+        ParametricSystem::Workspace workspace;
+        std::vector<double> values, voltages, currents;
+        std::vector<Histogram> local(histograms.size());
+        long long block;
+
+        while ((block = next++) < blockCount) {
+            std::vector<Moments> moments(2 * n);
+
+            long long failed = runBlock(block, trials, seed, workspace, values, voltages, currents, [&]() {
+                for (int i = 0; i < n; i++) {
+                    moments[2 * i].add(voltages[i]);
+                    moments[2 * i + 1].add(currents[i]);
+                }
+
+                if (!local.empty()) {
+                    for (int i = 0; i < n; i++) {
+                        local[2 * i].add(voltages[i], bins);
+                        local[2 * i + 1].add(currents[i], bins);
+                    }
+                }
+            });
+
+            std::lock_guard<std::mutex> lock(mutex);
+            finished.emplace(block, std::make_pair(failed, std::move(moments)));
+
+            while (!finished.empty() && finished.begin()->first == nextToMerge) {
+                result.failed += finished.begin()->second.first;
+
+                for (int q = 0; q < 2 * n; q++)
+                    totals[q].merge(finished.begin()->second.second[q]);
+
+                finished.erase(finished.begin());
+                nextToMerge++;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (int q = 0; q < int(local.size()); q++)
+            histograms[q].merge(local[q], bins);
+    });
+
+    result.components.resize(n);
+
+    for (int i = 0; i < n; i++) {
+        result.components[i].name = names[i];
+
+        for (int q = 0; q < 2; q++) {
+            const Moments& moments = totals[2 * i + q];
+            Statistics& statistics = q == 0 ? result.components[i].voltage
+                                            : result.components[i].current;
+
+            statistics.mean = moments.mean;
+            statistics.stdDev = moments.count > 1 ? std::sqrt(moments.m2 / (moments.count - 1)) : 0.0;
+            statistics.min = moments.min;
+            statistics.max = moments.max;
+
+            if (!histograms.empty()) {
+                const Histogram& histogram = histograms[2 * i + q];
+
+                statistics.binWidth = std::ldexp(1.0, histogram.exponent);
+                statistics.binStart = histogram.first * statistics.binWidth;
+                statistics.histogram = histogram.counts;
+            }
+        }
+    }
+
+    return result;
+}
+
+Tolerance MonteCarlo::parseTolerance(const std::string& text) {
+    Tolerance tolerance;
+    size_t colon = text.find(':');
+
+    if (colon == std::string::npos)
+        throw std::runtime_error("Expected <uniform|gauss>:<spread>, got " + text);
+
+    std::string kind = text.substr(0, colon),
+                spread = text.substr(colon + 1);
+
+    if (kind == "uniform")
+        tolerance.distribution = Tolerance::UNIFORM;
+    else if (kind == "gauss")
+        tolerance.distribution = Tolerance::GAUSSIAN;
+    else
+        throw std::runtime_error("Unknown distribution '" + kind + "' in " + text);
+
+    bool percent = !spread.empty() && spread.back() == '%';
+    if (percent)
+        spread.pop_back();
+
+    try {
+        size_t used;
+        tolerance.spread = std::stod(spread, &used);
+        if (used != spread.size())
+            throw std::invalid_argument(spread);
+    } catch (const std::exception&) {
+        throw std::runtime_error("Invalid spread '" + spread + "' in " + text);
+    }
+
+    if (tolerance.spread < 0.0)
+        throw std::runtime_error("The spread cannot be negative in " + text);
+
+    if (percent)
+        tolerance.spread /= 100.0;
+
+    return tolerance;
+}
\ No newline at end of file
@@ -0,0 +1,215 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         MonteCarlo.h
+    File Description:   Declares the Tolerance, Statistics, ComponentStatistics
+                        and MonteCarloResult structs and the MonteCarlo class.
+                        A MonteCarlo analysis solves a circuit many times with
+                        every resistor and voltage source drawn at random from
+                        its tolerance, and reports statistics of the results.
+                        Trials are grouped into fixed blocks that each have
+                        their own random number stream, so the results for a
+                        seed are the same on any number of threads.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstdint>         // uint64_t
+#include <functional>      // function class
+#include <map>             // map class
+#include <string>          // string class
+#include <vector>          // vector class
+#include "Circuit.h"
+#include "ParametricSystem.h"
+
+/**
+    How far a component's value may be from the value it is drawn with.
+*/
+struct Tolerance {
+    enum Distribution {
+        UNIFORM,
+        GAUSSIAN
+    };
+
+    Distribution distribution = UNIFORM;
+
+    // For UNIFORM, the largest deviation, and for GAUSSIAN, the standard
+    // deviation, both as a fraction of the component's value
+    double spread = 0.0;
+};
+
+/**
+    Statistics of one quantity over every solved trial.
+*/
+struct Statistics {
+    double mean = 0.0,
+           stdDev = 0.0,
+           min = 0.0,
+           max = 0.0;
+
+    // The number of trials in each of a set of equal bins. Bin k covers
+    // binStart + k * binWidth up to binStart + (k + 1) * binWidth. The width
+    // is a power of two and the bins start at a multiple of it, so the bins
+    // cover min to max but usually reach a little past them.
+    double binStart = 0.0,
+           binWidth = 0.0;
+    std::vector<long long> histogram;
+};
+
+/**
+    Statistics of the voltage drop across and current through a component.
+*/
+struct ComponentStatistics {
+    std::string name;
+    Statistics voltage,
+               current;
+};
+
+struct MonteCarloResult {
+    long long trials = 0,
+              failed = 0;
+    std::vector<ComponentStatistics> components;
+};
+
+class MonteCarlo {
+    private:
+        // The number of trials that share one random number stream. Changing
+        // it changes the results for every seed.
+        static const int BLOCK_SIZE = 256;
+
+        // The running count, mean, sum of squared differences from the mean,
+        // minimum and maximum of a quantity
+        struct Moments {
+            long long count = 0;
+            double mean = 0.0,
+                   m2 = 0.0,
+                   min = 0.0,
+                   max = 0.0;
+
+            /**
+                Description:   Adds a sample.
+                Return:        void
+                Precondition:  None
+                Postcondition: The moments will include the sample.
+            */
+            void add(double);
+
+            /**
+                Description:   Adds every sample of another set of moments.
+                Return:        void
+                Precondition:  None
+                Postcondition: The moments will include the other samples.
+                               The result depends on the order of merging.
+            */
+            void merge(const Moments&);
+        };
+
+        // Counts of a quantity in bins that are 2^exponent wide, where bin k
+        // covers (first + k) * 2^exponent up to (first + k + 1) * 2^exponent.
+        // Every bin edge is a multiple of the width, so two histograms are
+        // merged exactly by widening the bins of the finer one, and the
+        // result does not depend on the order samples are added in.
+        struct Histogram {
+            int exponent = 0;
+            long long first = 0;
+            std::vector<long long> counts;
+
+            /**
+                Description:   Adds a sample, widening the bins if the sample
+                               falls outside of them.
+                Return:        void
+                Precondition:  The maximum number of bins is at least two.
+                Postcondition: The histogram will include the sample, and
+                               will have no more than the maximum number of
+                               bins.
+            */
+            void add(double, int);
+
+            /**
+                Description:   Adds every sample of another histogram.
+                Return:        void
+                Precondition:  The maximum number of bins is at least two.
+                Postcondition: The histogram will include the other samples,
+                               and will have no more than the maximum number
+                               of bins.
+            */
+            void merge(const Histogram&, int);
+
+            /**
+                Description:   Widens the bins until they also cover bins lo
+                               through hi of the provided exponent.
+                Return:        void
+                Precondition:  The histogram is not empty, and the maximum
+                               number of bins is at least two.
+                Postcondition: The histogram will cover the bins, and will
+                               have no more than the maximum number of bins.
+                               The samples will be kept.
+            */
+            void widen(int, long long, long long, int);
+        };
+
+        ParametricSystem system;
+
+        // The names and tolerances of every resistor and voltage source, in
+        // the order they were added to the system
+        std::vector<std::string> names;
+        std::vector<Tolerance> tolerances;
+
+        /**
+            Description:   Solves every trial of a block, and passes the
+                           results of each solved trial to the callback.
+            Return:        long long
+            Precondition:  The workspace and vectors belong to the calling
+                           thread.
+            Postcondition: The number of trials that could not be solved is
+                           returned. This object will not be modified.
+        */
+        long long runBlock(long long, long long, std::uint64_t, ParametricSystem::Workspace&,
+                           std::vector<double>&, std::vector<double>&, std::vector<double>&,
+                           const std::function<void()>&) const;
+
+    public:
+        /**
+            Description:   Analyzes the circuit, and gives every resistor and
+                           voltage source the default tolerance unless another
+                           is provided for it by name.
+            Return:        None
+            Precondition:  The circuit has been initialized.
+            Postcondition: A MonteCarlo object is returned. Throws a
+                           runtime_error if the circuit is incomplete or cannot
+                           be analyzed, a name does not match a resistor or
+                           voltage source, or a component with a tolerance
+                           cannot vary (see ParametricSystem::canVary()).
+        */
+        MonteCarlo(const Circuit&, const Tolerance&, const std::map<std::string, Tolerance>& = std::map<std::string, Tolerance>());
+
+        /**
+            Description:   Solves the provided number of trials on the provided
+                           number of threads. If the number of bins is
+                           positive, every result is also counted in a
+                           histogram of at most that many bins (and no fewer
+                           than two) as it is solved.
+            Return:        MonteCarloResult
+            Precondition:  This object exists. If the number of threads is not
+                           positive, one thread per core is used.
+            Postcondition: The statistics of every resistor and voltage source
+                           are returned. They only depend on the number of
+                           trials, the seed and the number of bins. This
+                           object will not be modified.
+        */
+        MonteCarloResult run(long long, std::uint64_t, int, int = 20) const;
+
+        /**
+            Description:   Parses a tolerance of the form
+                               uniform:spread
+                               gauss:spread
+                           where spread is a fraction, or a percentage if it
+                           ends in '%'.
+            Return:        Tolerance
+            Precondition:  None
+            Postcondition: The tolerance is returned. Throws a runtime_error
+                           if the string cannot be parsed.
+        */
+        static Tolerance parseTolerance(const std::string&);
+};
\ No newline at end of file
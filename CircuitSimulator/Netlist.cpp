@@ -0,0 +1,24 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Netlist.cpp
+    File Description:   Implements the Netlist struct. The Netlist struct is
+                        the fully abstract form of the circuit used for nodal
+                        analysis.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include "Netlist.h"
+
+Netlist::Netlist(int nodeCount_) {
+    nodeCount = nodeCount_;
+}
+
+int Netlist::addBranch(int pos_, int neg_, double value_, Unit type_) {
+    pos.push_back(pos_);
+    neg.push_back(neg_);
+    value.push_back(value_);
+    type.push_back(type_);
+
+    return branchCount() - 1;
+}
\ No newline at end of file
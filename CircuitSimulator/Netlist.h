@@ -0,0 +1,72 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Netlist.h
+    File Description:   Declares the Netlist struct, along with the Unit enum.
+                        The Netlist struct is the fully abstract form of the
+                        circuit used for nodal analysis: every non-wire
+                        component is a branch between two numbered nodes.
+                        Branches are stored as parallel arrays rather than as
+                        objects, so the solver stages walk flat arrays instead
+                        of following pointers.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstdint>     // int32_t, uint8_t
+#include <vector>      // vector class
+
+/**
+    The ComponentType of the nodal analysis process - keeps track of whether
+    or not a branch is a resistor or voltage source.
+*/
+enum class Unit : std::uint8_t {
+    OHM,
+    VOLT
+};
+
+struct Netlist {
+    int nodeCount = 0;
+
+    // Branch k runs from its positive node pos[k] to its negative node
+    // neg[k], and has a value of value[k] in the units of type[k]
+    std::vector<std::int32_t> pos,
+                              neg;
+    std::vector<double> value;
+    std::vector<Unit> type;
+
+    /**
+        Description:   Initializes an empty Netlist object.
+        Return:        None
+        Precondition:  None
+        Postcondition: A Netlist with no nodes or branches is returned.
+    */
+    Netlist() = default;
+
+    /**
+        Description:   Initializes a Netlist object with the provided number
+                       of nodes and no branches.
+        Return:        None
+        Precondition:  The number of nodes is not negative.
+        Postcondition: A Netlist with no branches is returned.
+    */
+    explicit Netlist(int);
+
+    /**
+        Description:   Returns the number of branches.
+        Return:        int
+        Precondition:  This object exists.
+        Postcondition: The number of branches is returned. This object will
+                       not be modified.
+    */
+    inline int branchCount() const { return int(pos.size()); }
+
+    /**
+        Description:   Adds a branch between two nodes.
+        Return:        int
+        Precondition:  Both nodes are less than nodeCount.
+        Postcondition: The index of the new branch is returned.
+    */
+    int addBranch(int, int, double, Unit);
+};
\ No newline at end of file
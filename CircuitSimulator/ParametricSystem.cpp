@@ -0,0 +1,144 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         ParametricSystem.cpp
+    File Description:   Implements the ParametricSystem class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <stdexcept>      // runtime_error
+#include "ParametricSystem.h"
+
+ParametricSystem::ParametricSystem(const Circuit& circuit) {
+    std::vector<GridSpot*> populatedSpots;
+
+    if (!Calculator::getPopulatedSpots(circuit.getSpots(), populatedSpots))
+        throw std::runtime_error("The circuit is incomplete");
+
+    system = Calculator::buildSystem(populatedSpots);
+
+    // Factor the circuit as drawn to find the ordering and pattern that
+    // every solve shares
+    SparseLU lu;
+    Calculator::getSymbolicCache().factorize(system.matrix, lu);
+    symbolic = lu.getSymbolic();
+}
+
+int ParametricSystem::addComponent(const Circuit& circuit, int i) {
+    Component* component = circuit.getComponents()[i];
+
+    Target target;
+    target.type = component->type;
+    target.value = component->value;
+    target.pos = component->positive->node;
+    target.neg = component->negative->node;
+    target.row = -1;
+
+    // A resistor's conductance appears at four entries of the matrix (see
+    // Calculator::buildSystem()). A node's KCL row is also the column of its
+    // voltage.
+    const int pos = system.kclRows[target.pos],
+              neg = system.kclRows[target.neg];
+    const int rows[4] = { pos, pos, neg, neg };
+    const int cols[4] = { pos, neg, neg, pos };
+
+    for (int e = 0; e < 4; e++) {
+        if (rows[e] == -1 || cols[e] == -1) {
+            target.entries[e] = -1;
+        } else {
+            int entry = system.matrix.find(rows[e], cols[e]);
+            target.entries[e] = entry == -1 ? -2 : entry;
+        }
+    }
+
+    if (component->type == &VSRC)
+        target.row = system.sourceRows.at(std::make_pair(target.pos, target.neg));
+
+    targets.push_back(target);
+    return int(targets.size()) - 1;
+}
+
+bool ParametricSystem::canVary(int i) const {
+    if (targets[i].type == &VSRC)
+        return true;
+
+    for (int e = 0; e < 4; e++) {
+        if (targets[i].entries[e] == -2)
+            return false;
+    }
+
+    return true;
+}
+
+int ParametricSystem::getComponentCount() const {
+    return int(targets.size());
+}
+
+double ParametricSystem::getValue(int i) const {
+    return targets[i].value;
+}
+
+const ComponentType* ParametricSystem::getType(int i) const {
+    return targets[i].type;
+}
+
+bool ParametricSystem::solve(const std::vector<double>& values, Workspace& workspace) const {
+    // Start from the circuit as drawn, and apply the change in each
+    // component's value. Conductances of parallel resistors add, so each
+    // change can be applied on its own. A new workspace needs the pattern as
+    // well as the values.
+    if (workspace.matrix.colPtr.empty())
+        workspace.matrix = system.matrix;
+    else
+        workspace.matrix.values = system.matrix.values;
+
+    workspace.x = system.coeff;
+
+    for (int i = 0; i < int(targets.size()); i++) {
+        const Target& target = targets[i];
+
+        if (values[i] == target.value)
+            continue;
+
+        if (target.type == &RESISTOR) {
+            double delta = 1.0 / values[i] - 1.0 / target.value;
+
+            for (int e = 0; e < 4; e++) {
+                if (target.entries[e] >= 0)
+                    workspace.matrix.values[target.entries[e]] += e % 2 == 0 ? delta : -delta;
+            }
+        } else {
+            workspace.x[target.row] = values[i];
+        }
+    }
+
+    try {
+        workspace.lu.refactorize(workspace.matrix, symbolic);
+        workspace.lu.solve(workspace.x);
+    } catch (const std::runtime_error&) {
+        return false;
+    }
+
+    return true;
+}
+
+void ParametricSystem::getResult(const Workspace& workspace, int i, double value,
+                                 double& voltage, double& current) const {
+    const Target& target = targets[i];
+
+    // A node's voltage is at its KCL row. The ground node is at 0 V.
+    auto voltageAt = [&](int node) {
+        int row = system.kclRows[node];
+        return row == -1 ? 0.0 : workspace.x[row];
+    };
+
+    if (target.type == &RESISTOR) {
+        voltage = voltageAt(target.pos) - voltageAt(target.neg);
+        current = voltage / value;
+    } else {
+        // The source's unknown is the current flowing into its positive
+        // terminal, so the current it supplies is the negative of that
+        voltage = value;
+        current = -workspace.x[target.row];
+    }
+}
\ No newline at end of file
@@ -0,0 +1,149 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         ParametricSystem.h
+    File Description:   Declares the ParametricSystem class. A ParametricSystem
+                        is the nodal analysis system of a circuit that is
+                        solved many times with different component values but
+                        the same topology, as in a sweep or a Monte Carlo
+                        analysis. The system is built and symbolically
+                        factored once, and each solve only patches the
+                        entries that depend on the changed values before a
+                        numeric refactorization. Solves only read this object,
+                        so any number of threads can solve at once, each with
+                        its own Workspace.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <memory>          // shared_ptr class
+#include <vector>          // vector class
+#include "Calculator.h"
+#include "Circuit.h"
+#include "SparseLU.h"
+#include "SparseMatrix.h"
+
+class ParametricSystem {
+    public:
+        /**
+            The state used by one thread to solve the system.
+        */
+        struct Workspace {
+            SparseMatrix matrix;
+            std::vector<double> x;
+            SparseLU lu;
+        };
+
+    private:
+        // A component of the circuit, along with where its value appears in
+        // the system
+        struct Target {
+            const ComponentType* type;
+            double value;
+
+            // The ids of the nodes at the component's ends
+            int pos,
+                neg;
+
+            // For resistors, the indices in the matrix's values of the
+            // entries at (pos, pos), (pos, neg), (neg, neg) and (neg, pos),
+            // -1 for the ground node's row or column, or -2 if the entry is
+            // not stored.
+            // For voltage sources, the row of the source's equation and
+            // current.
+            int entries[4];
+            int row;
+        };
+
+        NodalSystem system;
+        std::shared_ptr<const LUSymbolic> symbolic;
+        std::vector<Target> targets;
+
+    public:
+        /**
+            Description:   Builds and symbolically factors the system of the
+                           circuit as it is drawn.
+            Return:        None
+            Precondition:  The circuit has been initialized.
+            Postcondition: A ParametricSystem object with no components is
+                           returned. Throws a runtime_error if the circuit is
+                           incomplete or cannot be solved.
+        */
+        ParametricSystem(const Circuit&);
+
+        /**
+            Description:   Adds the circuit's component at the provided index,
+                           so that its value can be changed and its results
+                           read.
+            Return:        int
+            Precondition:  The component is a resistor or voltage source of
+                           the circuit this object was built from.
+            Postcondition: The index of the component in this object is
+                           returned.
+        */
+        int addComponent(const Circuit&, int);
+
+        /**
+            Description:   Returns whether a component's value can be changed.
+                           A resistor cannot be if it was reduced away along
+                           with parallel resistors (see
+                           Calculator::reduceNodes()).
+            Return:        bool
+            Precondition:  The component has been added.
+            Postcondition: Whether the value can be changed is returned. This
+                           object will not be modified.
+        */
+        bool canVary(int) const;
+
+        /**
+            Description:   Returns the number of added components.
+            Return:        int
+            Precondition:  This object exists.
+            Postcondition: The number of components is returned. This object
+                           will not be modified.
+        */
+        int getComponentCount() const;
+
+        /**
+            Description:   Returns the value of a component in the circuit as
+                           drawn.
+            Return:        double
+            Precondition:  The component has been added.
+            Postcondition: The value is returned. This object will not be
+                           modified.
+        */
+        double getValue(int) const;
+
+        /**
+            Description:   Returns the type of a component.
+            Return:        const ComponentType*
+            Precondition:  The component has been added.
+            Postcondition: The type is returned. This object will not be
+                           modified.
+        */
+        const ComponentType* getType(int) const;
+
+        /**
+            Description:   Solves the system with every added component set to
+                           the provided value.
+            Return:        bool
+            Precondition:  There is one value per added component, and only
+                           components that can vary have changed values.
+            Postcondition: The workspace will hold the solution. Returns false
+                           if the system cannot be solved with these values.
+                           This object will not be modified.
+        */
+        bool solve(const std::vector<double>&, Workspace&) const;
+
+        /**
+            Description:   Reads the voltage drop across and current through a
+                           component from the last solve.
+            Return:        void
+            Precondition:  The workspace holds a solution, and the value is
+                           the one the component was solved with.
+            Postcondition: The voltage and current are set. This object will
+                           not be modified.
+        */
+        void getResult(const Workspace&, int, double, double&, double&) const;
+};
\ No newline at end of file
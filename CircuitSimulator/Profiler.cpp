@@ -0,0 +1,244 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Profiler.cpp
+    File Description:   Implements the Profiler namespace. When profiling is
+                        enabled, this file also replaces the global operator
+                        new so that allocations can be counted per thread.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // max
+#include <atomic>         // atomic class
+#include <chrono>         // steady_clock
+#include <cstdlib>        // malloc, free
+#include <map>            // map class
+#include <mutex>          // mutex, lock_guard
+#include <new>            // bad_alloc
+#include "Profiler.h"
+
+namespace {
+    // Events are kept until reset(), so a long session cannot use an
+    // unbounded amount of memory
+    const size_t MAX_EVENTS = 1000000;
+
+    std::mutex mutex;
+    std::vector<Profiler::Event> events;
+    long long dropped = 0;
+
+#ifdef CIRCUIT_PROFILING
+    thread_local long long allocations = 0;
+#endif
+
+    const std::chrono::steady_clock::time_point epoch = std::chrono::steady_clock::now();
+
+    /**
+        Description:   Returns the time since the profiler started.
+        Return:        long long
+        Precondition:  None
+        Postcondition: The time is returned, in nanoseconds.
+    */
+    long long now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count();
+    }
+
+    /**
+        Description:   Returns a small number identifying the calling thread.
+        Return:        int
+        Precondition:  None
+        Postcondition: The same number is returned for every call on a
+                       thread.
+    */
+    int getThread() {
+        static std::atomic<int> threadCount(0);
+        thread_local int thread = threadCount++;
+        return thread;
+    }
+
+    /**
+        Description:   Records an event.
+        Return:        void
+        Precondition:  None
+        Postcondition: The event is recorded, or counted as dropped if the
+                       profiler is full.
+    */
+    void record(const Profiler::Event& event) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        if (events.size() < MAX_EVENTS)
+            events.push_back(event);
+        else
+            dropped++;
+    }
+
+    /**
+        Description:   Escapes a string for a JSON string literal.
+        Return:        string
+        Precondition:  None
+        Postcondition: The quoted string is returned.
+    */
+    std::string quote(const std::string& text) {
+        std::string quoted = "\"";
+
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c;
+        }
+
+        return quoted + "\"";
+    }
+}
+
+#ifdef CIRCUIT_PROFILING
+void* operator new(std::size_t size) {
+    allocations++;
+
+    if (void* pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* pointer) noexcept {
+    std::free(pointer);
+}
+
+void operator delete(void* pointer, std::size_t) noexcept {
+    std::free(pointer);
+}
+#endif
+
+Profiler::Scope::Scope(const char* name_) : name(name_) {
+    allocations = getAllocationCount();
+    start = now();
+}
+
+Profiler::Scope::~Scope() {
+    long long end = now();
+    record({ name, start, end - start, getAllocationCount() - allocations, getThread() });
+}
+
+bool Profiler::isEnabled() {
+#ifdef CIRCUIT_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+void Profiler::count(const char* name, long long value) {
+    record({ name, now(), -1, value, getThread() });
+}
+
+long long Profiler::getAllocationCount() {
+#ifdef CIRCUIT_PROFILING
+    return allocations;
+#else
+    return 0;
+#endif
+}
+
+std::vector<Profiler::Event> Profiler::getEvents() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return events;
+}
+
+std::vector<Profiler::Stage> Profiler::getStages() {
+    std::vector<Stage> stages;
+    std::map<std::string, int> index;
+
+    for (const Event& event : getEvents()) {
+        if (event.duration < 0)
+            continue;
+
+        auto found = index.find(event.name);
+        if (found == index.end()) {
+            found = index.emplace(event.name, int(stages.size())).first;
+            stages.emplace_back();
+            stages.back().name = event.name;
+        }
+
+        Stage& stage = stages[found->second];
+        double seconds = event.duration * 1e-9;
+
+        stage.calls++;
+        stage.allocations += event.value;
+        stage.totalSeconds += seconds;
+        stage.maxSeconds = std::max(stage.maxSeconds, seconds);
+    }
+
+    return stages;
+}
+
+long long Profiler::getDroppedCount() {
+    std::lock_guard<std::mutex> lock(mutex);
+    return dropped;
+}
+
+void Profiler::reset() {
+    std::lock_guard<std::mutex> lock(mutex);
+    events.clear();
+    dropped = 0;
+}
+
+void Profiler::writeJson(std::ostream& out) {
+    std::vector<Event> recorded = getEvents();
+
+    out << "{\"enabled\": " << (isEnabled() ? "true" : "false")
+        << ", \"dropped\": " << getDroppedCount() << ",\n \"stages\": [";
+
+    std::vector<Stage> stages = getStages();
+    for (int i = 0; i < int(stages.size()); i++) {
+        const Stage& stage = stages[i];
+
+        out << (i == 0 ? "\n  " : ",\n  ") << "{\"name\": " << quote(stage.name)
+            << ", \"calls\": " << stage.calls << ", \"totalSeconds\": " << stage.totalSeconds
+            << ", \"maxSeconds\": " << stage.maxSeconds << ", \"allocations\": "
+            << stage.allocations << "}";
+    }
+
+    // The last value of each counter
+    std::map<std::string, long long> counters;
+    std::vector<std::string> order;
+
+    for (const Event& event : recorded) {
+        if (event.duration >= 0)
+            continue;
+
+        if (counters.find(event.name) == counters.end())
+            order.push_back(event.name);
+
+        counters[event.name] = event.value;
+    }
+
+    out << "],\n \"counters\": {";
+
+    for (int i = 0; i < int(order.size()); i++)
+        out << (i == 0 ? "" : ", ") << quote(order[i]) << ": " << counters[order[i]];
+
+    out << "}}\n";
+}
+
+void Profiler::writeTrace(std::ostream& out) {
+    std::vector<Event> recorded = getEvents();
+
+    // Trace times are in microseconds
+    out << "{\"displayTimeUnit\": \"ms\", \"traceEvents\": [";
+
+    for (int i = 0; i < int(recorded.size()); i++) {
+        const Event& event = recorded[i];
+
+        out << (i == 0 ? "\n" : ",\n") << "{\"name\": " << quote(event.name)
+            << ", \"pid\": 1, \"tid\": " << event.thread << ", \"ts\": " << event.start / 1000.0;
+
+        if (event.duration >= 0) {
+            out << ", \"ph\": \"X\", \"dur\": " << event.duration / 1000.0
+                << ", \"args\": {\"allocations\": " << event.value << "}}";
+        } else {
+            out << ", \"ph\": \"C\", \"args\": {\"value\": " << event.value << "}}";
+        }
+    }
+
+    out << "\n]}\n";
+}
\ No newline at end of file
@@ -0,0 +1,173 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Profiler.h
+    File Description:   Declares the Profiler namespace, along with the
+                        PROFILE_SCOPE and PROFILE_COUNT macros. The macros
+                        record how long each stage of the solver takes, how
+                        many allocations it makes, and the sizes it works on
+                        (spots, nodes, branches, nonzeros). They only do
+                        anything when the program is built with
+                        CIRCUIT_PROFILING defined (the CIRCUIT_PROFILING CMake
+                        option); otherwise they compile to nothing, and the
+                        Profiler functions report no events.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <ostream>         // ostream class
+#include <string>          // string class
+#include <vector>          // vector class
+
+#ifdef CIRCUIT_PROFILING
+#define PROFILE_CONCAT_(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_(a, b)
+
+// Times the rest of the enclosing block. The name must be a string literal.
+#define PROFILE_SCOPE(name) Profiler::Scope PROFILE_CONCAT(profileScope, __LINE__)(name)
+
+// Records the value of a counter. The name must be a string literal. The
+// value is not evaluated when profiling is disabled.
+#define PROFILE_COUNT(name, value) Profiler::count(name, (long long)(value))
+#else
+#define PROFILE_SCOPE(name) ((void)0)
+#define PROFILE_COUNT(name, value) ((void)0)
+#endif
+
+namespace Profiler {
+    /**
+        One timed scope, or one counter value if duration is -1.
+    */
+    struct Event {
+        const char* name;
+
+        // Nanoseconds since the profiler started
+        long long start,
+                  duration;
+
+        // For scopes, the allocations made on the thread during the scope.
+        // For counters, the value.
+        long long value;
+
+        // A small number identifying the thread
+        int thread;
+    };
+
+    /**
+        The totals of every scope with the same name.
+    */
+    struct Stage {
+        std::string name;
+        long long calls = 0,
+                  allocations = 0;
+        double totalSeconds = 0.0,
+               maxSeconds = 0.0;
+    };
+
+    class Scope {
+        private:
+            const char* name;
+            long long start,
+                      allocations;
+
+        public:
+            /**
+                Description:   Starts timing a scope.
+                Return:        None
+                Precondition:  The name outlives the profiler's events.
+                Postcondition: A Scope object is returned.
+            */
+            explicit Scope(const char*);
+
+            // A scope is tied to the block it times
+            Scope(const Scope&) = delete;
+            Scope& operator =(const Scope&) = delete;
+
+            /**
+                Description:   Records the scope's time and allocations.
+                Return:        None
+                Precondition:  This object exists.
+                Postcondition: An event will have been recorded.
+            */
+            ~Scope();
+    };
+
+    /**
+        Description:   Returns whether the program was built with profiling.
+        Return:        bool
+        Precondition:  None
+        Postcondition: Whether profiling is compiled in is returned.
+    */
+    bool isEnabled();
+
+    /**
+        Description:   Records the value of a counter.
+        Return:        void
+        Precondition:  The name outlives the profiler's events.
+        Postcondition: An event will have been recorded.
+    */
+    void count(const char*, long long);
+
+    /**
+        Description:   Returns the number of allocations made by the calling
+                       thread so far.
+        Return:        long long
+        Precondition:  None
+        Postcondition: The number of allocations is returned, or 0 if
+                       profiling is disabled.
+    */
+    long long getAllocationCount();
+
+    /**
+        Description:   Returns every recorded event, in the order they ended.
+        Return:        vector<Event>
+        Precondition:  None
+        Postcondition: A copy of the events is returned.
+    */
+    std::vector<Event> getEvents();
+
+    /**
+        Description:   Returns the totals of every scope name, in the order
+                       each name was first recorded.
+        Return:        vector<Stage>
+        Precondition:  None
+        Postcondition: The totals are returned.
+    */
+    std::vector<Stage> getStages();
+
+    /**
+        Description:   Returns the number of events that were not recorded
+                       because the profiler was full.
+        Return:        long long
+        Precondition:  None
+        Postcondition: The number of dropped events is returned.
+    */
+    long long getDroppedCount();
+
+    /**
+        Description:   Removes every recorded event.
+        Return:        void
+        Precondition:  None
+        Postcondition: No events will be recorded.
+    */
+    void reset();
+
+    /**
+        Description:   Writes the stage totals and the last value of every
+                       counter as JSON.
+        Return:        void
+        Precondition:  None
+        Postcondition: The summary is written to the stream.
+    */
+    void writeJson(std::ostream&);
+
+    /**
+        Description:   Writes every event in the trace event format read by
+                       chrome://tracing and Perfetto.
+        Return:        void
+        Precondition:  None
+        Postcondition: The trace is written to the stream.
+    */
+    void writeTrace(std::ostream&);
+}
\ No newline at end of file
@@ -0,0 +1,327 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Solver.cpp
+    File Description:   Implements the Solver class. This class solves
+                        circuits like Calculator, but reuses the factored
+                        system when only component values have changed.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // max, minmax, swap
+#include <cmath>          // fabs, isfinite
+#include "Profiler.h"
+#include "Solver.h"
+
+bool Solver::solve(const spot_vec& spots, const std::vector<Component*>& components_) {
+    // Changing a resistor's value only changes the conductance between its
+    // two nodes, which is a rank-one change to the matrix, and changing a
+    // voltage source's value only changes the coefficient vector. Neither
+    // needs the nodes to be found or the matrix to be factored again.
+    if (valid && isSameTopology(components_) && update(components_))
+        return true;
+
+    return rebuild(spots, components_);
+}
+
+void Solver::reset() {
+    valid = false;
+    system = NodalSystem();
+    components.clear();
+    types.clear();
+    positives.clear();
+    negatives.clear();
+    values.clear();
+    branches.clear();
+    updates.clear();
+    updateIndex.clear();
+}
+
+bool Solver::rebuild(const spot_vec& spots, const std::vector<Component*>& components_) {
+    PROFILE_SCOPE("Solver::rebuild");
+
+    reset();
+
+    std::vector<GridSpot*> populatedSpots;
+
+    if (!Calculator::getPopulatedSpots(spots, populatedSpots)) {
+        Calculator::clearComponentValues(components_);
+        return false;
+    }
+
+    system = Calculator::buildSystem(populatedSpots);
+    Calculator::getSymbolicCache().factorize(system.matrix, lu);
+
+    std::vector<double> solution = system.coeff;
+    lu.solve(solution);
+
+    // Remember the circuit the system was built from, so later calls can
+    // tell which values have changed.
+    for (Component* component : components_) {
+        components.push_back(component);
+        types.push_back(component->type);
+        positives.push_back(component->positive);
+        negatives.push_back(component->negative);
+        values.push_back(component->value);
+
+        if (component->type != &WIRE) {
+            auto key = std::minmax(component->positive->node,
+                                   component->negative->node);
+            auto& branch = branches[key];
+
+            if (component->type == &RESISTOR)
+                branch.first += 1.0 / component->value;
+            branch.second++;
+        }
+    }
+
+    valid = true;
+
+    Calculator::setComponentValues(system, solution, components_);
+
+    return true;
+}
+
+bool Solver::isSameTopology(const std::vector<Component*>& components_) const {
+    if (components_.size() != components.size())
+        return false;
+
+    for (int i = 0; i < int(components.size()); i++) {
+        if (components_[i] != components[i] ||
+            components_[i]->type != types[i] ||
+            components_[i]->positive != positives[i] ||
+            components_[i]->negative != negatives[i])
+            return false;
+    }
+
+    return true;
+}
+
+bool Solver::update(const std::vector<Component*>& components_) {
+    PROFILE_SCOPE("Solver::update");
+
+    for (int i = 0; i < int(components.size()); i++) {
+        double value = components_[i]->value;
+
+        if (value == values[i])
+            continue;
+
+        int pos = positives[i]->node,
+            neg = negatives[i]->node;
+
+        if (types[i] == &RESISTOR) {
+            if (value == 0.0 || !std::isfinite(value))
+                return false;
+
+            auto key = std::minmax(pos, neg);
+            auto& branch = branches.at(key);
+            double delta = 1.0 / value - 1.0 / values[i];
+
+            // Parallel resistors are reduced to one equivalent resistor,
+            // which cannot be written if the change cancels the group's
+            // conductance (see Calculator::reduceNodes())
+            if (branch.second > 1 && branch.first + delta == 0.0)
+                return false;
+
+            if (!addUpdate(key.first, key.second, delta))
+                return false;
+
+            branch.first += delta;
+        } else if (types[i] == &VSRC) {
+            auto row = system.sourceRows.find(std::make_pair(pos, neg));
+            if (row == system.sourceRows.end())
+                return false;
+
+            system.coeff[row->second] = value;
+        }
+
+        values[i] = value;
+    }
+
+    std::vector<double> solution;
+    if (!solveUpdated(solution))
+        return false;
+
+    Calculator::setComponentValues(system, solution, components_);
+
+    return true;
+}
+
+bool Solver::addUpdate(int pos, int neg, double scale) {
+    auto existing = updateIndex.find(std::make_pair(pos, neg));
+
+    // The vectors u and v only depend on the nodes, so a second change to
+    // the same pair of nodes only changes the scale.
+    if (existing != updateIndex.end()) {
+        updates[existing->second].scale += scale;
+        return true;
+    }
+
+    if (int(updates.size()) == MAX_UPDATES && !foldUpdates())
+        return false;
+
+    // The KCL row of the positive node has +g at the positive node and -g
+    // at the negative node, and the KCL row of the negative node has the
+    // opposite. The ground node has no KCL row or column.
+    int posRow = system.kclRows[pos],
+        negRow = system.kclRows[neg];
+
+    Update update;
+    update.pos = pos;
+    update.neg = neg;
+    update.scale = scale;
+    update.w.assign(system.matrix.rows, 0.0);
+
+    if (posRow != -1)
+        update.w[posRow] += 1.0;
+    if (negRow != -1)
+        update.w[negRow] -= 1.0;
+
+    lu.solve(update.w);
+
+    updateIndex[std::make_pair(pos, neg)] = int(updates.size());
+    updates.push_back(update);
+
+    return true;
+}
+
+bool Solver::foldUpdates() {
+    PROFILE_SCOPE("Solver::foldUpdates");
+
+    // Each update adds +scale at (posRow, pos) and (negRow, neg), and -scale
+    // at (posRow, neg) and (negRow, pos). These entries were all written when
+    // the system was built, so they are already stored in the matrix.
+    for (const Update& update : updates) {
+        // A node's KCL row is also the column of its voltage
+        const int rows[2] = { system.kclRows[update.pos], system.kclRows[update.neg] };
+        const int* cols = rows;
+
+        for (int r = 0; r < 2; r++) {
+            if (rows[r] == -1)
+                continue;
+
+            for (int c = 0; c < 2; c++) {
+                if (cols[c] == -1)
+                    continue;
+
+                int entry = system.matrix.find(rows[r], cols[c]);
+                if (entry == -1)
+                    return false;
+
+                system.matrix.values[entry] += r == c ? update.scale : -update.scale;
+            }
+        }
+    }
+
+    updates.clear();
+    updateIndex.clear();
+
+    // The matrix has the same pattern, so only the numeric factorization has
+    // to be redone. If the updated matrix turns out to be singular, the
+    // stored system no longer matches the factors.
+    valid = false;
+    lu.refactorize(system.matrix, lu.getSymbolic());
+    valid = true;
+
+    return true;
+}
+
+bool Solver::solveUpdated(std::vector<double>& x) const {
+    // Solve the original system first
+    x = system.coeff;
+    lu.solve(x);
+
+    // By the Woodbury identity, the solution of the updated system is
+    // x - W * (I + D * V^T * W)^-1 * D * V^T * x, where the columns of W
+    // are the stored solutions for each u, and D holds the scales. This
+    // only takes a small dense solve with one row per update.
+    const int k = int(updates.size());
+
+    // The voltage of a node in a solution vector. The ground node is at 0 V.
+    auto voltage = [this](const std::vector<double>& solution, int node) {
+        int row = system.kclRows[node];
+        return row == -1 ? 0.0 : solution[row];
+    };
+
+    if (k > 0) {
+        std::vector<double> c(k * k),
+                            z(k);
+
+        for (int i = 0; i < k; i++) {
+            const Update& ui = updates[i];
+
+            for (int j = 0; j < k; j++)
+                c[i * k + j] = (i == j ? 1.0 : 0.0) +
+                               ui.scale * (voltage(updates[j].w, ui.pos) - voltage(updates[j].w, ui.neg));
+
+            z[i] = ui.scale * (voltage(x, ui.pos) - voltage(x, ui.neg));
+        }
+
+        // Gaussian elimination with partial pivoting
+        for (int col = 0; col < k; col++) {
+            int pivot = col;
+            for (int row = col + 1; row < k; row++) {
+                if (fabs(c[row * k + col]) > fabs(c[pivot * k + col]))
+                    pivot = row;
+            }
+
+            if (fabs(c[pivot * k + col]) < 1e-12)
+                return false;
+
+            if (pivot != col) {
+                for (int j = 0; j < k; j++)
+                    std::swap(c[col * k + j], c[pivot * k + j]);
+                std::swap(z[col], z[pivot]);
+            }
+
+            for (int row = col + 1; row < k; row++) {
+                double factor = c[row * k + col] / c[col * k + col];
+
+                for (int j = col; j < k; j++)
+                    c[row * k + j] -= factor * c[col * k + j];
+                z[row] -= factor * z[col];
+            }
+        }
+
+        for (int row = k - 1; row >= 0; row--) {
+            for (int j = row + 1; j < k; j++)
+                z[row] -= c[row * k + j] * z[j];
+            z[row] /= c[row * k + row];
+        }
+
+        for (int j = 0; j < k; j++) {
+            for (int i = 0; i < int(x.size()); i++)
+                x[i] -= updates[j].w[i] * z[j];
+        }
+    }
+
+    // Updates that nearly cancel the original matrix lose accuracy, so
+    // check the residual of the updated system before accepting it.
+    std::vector<double> residual;
+    system.matrix.multiply(x, residual);
+
+    for (const Update& update : updates) {
+        double s = update.scale * (voltage(x, update.pos) - voltage(x, update.neg));
+
+        if (system.kclRows[update.pos] != -1)
+            residual[system.kclRows[update.pos]] += s;
+        if (system.kclRows[update.neg] != -1)
+            residual[system.kclRows[update.neg]] -= s;
+    }
+
+    double maxMatrix = 0.0,
+           maxX = 0.0,
+           maxCoeff = 0.0,
+           maxResidual = 0.0;
+
+    for (double value : system.matrix.values)
+        maxMatrix = std::max(maxMatrix, fabs(value));
+
+    for (int i = 0; i < int(x.size()); i++) {
+        maxX = std::max(maxX, fabs(x[i]));
+        maxCoeff = std::max(maxCoeff, fabs(system.coeff[i]));
+        maxResidual = std::max(maxResidual, fabs(residual[i] - system.coeff[i]));
+    }
+
+    return std::isfinite(maxResidual) && maxResidual <= 1e-9 * (maxMatrix * maxX + maxCoeff);
+}
\ No newline at end of file
@@ -0,0 +1,162 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Solver.h
+    File Description:   Declares the Solver class. Unlike Calculator, which
+                        solves a circuit from scratch on every call, a Solver
+                        remembers the factored system of the last circuit it
+                        solved. When only component values have changed since
+                        then, the existing factorization is updated instead of
+                        redoing the nodal analysis.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <map>             // map class
+#include <utility>         // pair class
+#include <vector>          // vector class
+#include "Calculator.h"
+#include "Component.h"
+#include "ComponentTypes.h"
+#include "GridSpot.h"
+#include "SparseLU.h"
+
+class Solver {
+    private:
+        // A change to the conductance between two nodes. It changes the
+        // matrix by scale * u * v^T, where v has +1 at the first node and -1
+        // at the second, and u is made of the KCL rows of the two nodes.
+        struct Update {
+            int pos,
+                neg;
+            double scale;
+
+            // The solution of the factored system for u
+            std::vector<double> w;
+        };
+
+        // After this many distinct updates, the updates are written into the
+        // matrix and it is factored again.
+        static const int MAX_UPDATES = 16;
+
+        // Whether the members below describe the last circuit solved
+        bool valid = false;
+
+        NodalSystem system;
+        SparseLU lu;
+
+        // The topology and values of the circuit the system was built from
+        std::vector<Component*> components;
+        std::vector<const ComponentType*> types;
+        std::vector<GridSpot*> positives,
+                               negatives;
+        std::vector<double> values;
+
+        // The total conductance and number of non-wire components between
+        // each pair of nodes, keyed by the lower node id first
+        std::map<std::pair<int, int>, std::pair<double, int>> branches;
+
+        // The low-rank changes made to the factored matrix so far, and the
+        // index of the update for each pair of nodes
+        std::vector<Update> updates;
+        std::map<std::pair<int, int>, int> updateIndex;
+
+        /**
+            Description:   Builds and factors the system for the circuit from
+                           scratch, and solves it.
+            Return:        bool
+            Precondition:  The arguments contain all circuit GridSpots and
+                           components, respectively.
+            Postcondition: Behaves like Calculator::calculate(). The system
+                           will be remembered if the circuit is complete.
+        */
+        bool rebuild(const spot_vec&, const std::vector<Component*>&);
+
+        /**
+            Description:   Determines whether the components have the same
+                           types and endpoints as when the system was built.
+            Return:        bool
+            Precondition:  This object exists.
+            Postcondition: Returns true if only component values can have
+                           changed. This object will not be modified.
+        */
+        bool isSameTopology(const std::vector<Component*>&) const;
+
+        /**
+            Description:   Applies the changes in component values to the
+                           factored system and solves it.
+            Return:        bool
+            Precondition:  isSameTopology() returned true for the components.
+            Postcondition: Returns true if the components have been given
+                           their new voltages and currents. Returns false if
+                           the change cannot be applied as an update, in
+                           which case the system must be rebuilt.
+        */
+        bool update(const std::vector<Component*>&);
+
+        /**
+            Description:   Adds a change in conductance between two nodes to
+                           the list of updates.
+            Return:        bool
+            Precondition:  The node ids are part of the system.
+            Postcondition: Returns false if the update cannot be made, true
+                           otherwise.
+        */
+        bool addUpdate(int, int, double);
+
+        /**
+            Description:   Writes every update into the matrix and factors it
+                           again, so later updates start from an empty list.
+            Return:        bool
+            Precondition:  The factors and updates describe the current
+                           circuit.
+            Postcondition: Returns true if the matrix has been refactored and
+                           the updates cleared. Returns false if an update
+                           touches an entry that is not stored in the matrix.
+        */
+        bool foldUpdates();
+
+        /**
+            Description:   Solves the updated system using the Woodbury
+                           identity, and checks the residual of the result.
+            Return:        bool
+            Precondition:  The factors and updates describe the current
+                           circuit.
+            Postcondition: The vector will hold the node voltages. Returns
+                           false if the updated system is singular or the
+                           solution is not accurate enough.
+        */
+        bool solveUpdated(std::vector<double>&) const;
+
+    public:
+        /**
+            Description:   Initializes a Solver object with no stored system.
+            Return:        None
+            Precondition:  None
+            Postcondition: A Solver object is returned.
+        */
+        Solver() = default;
+
+        /**
+            Description:   Given a complete list of all components and
+                           GridSpots, calculates the current through and
+                           voltage across each component. If the circuit has
+                           the same topology as the last one solved, the
+                           stored factorization is reused.
+            Return:        bool
+            Precondition:  The GridSpot and Component vectors contain all
+                           circuit GridSpots and components, respectively.
+            Postcondition: Behaves like Calculator::calculate().
+        */
+        bool solve(const spot_vec&, const std::vector<Component*>&);
+
+        /**
+            Description:   Forgets the stored system, so the next call to
+                           solve() starts from scratch.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: The stored system will have been discarded.
+        */
+        void reset();
+};
\ No newline at end of file
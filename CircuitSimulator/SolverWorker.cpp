@@ -0,0 +1,146 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SolverWorker.cpp
+    File Description:   Implements the SolverWorker class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <chrono>         // milliseconds
+#include <utility>        // move
+#include "SolverWorker.h"
+#include "GridSpot.h"
+
+SolverWorker::SolverWorker() : thread(&SolverWorker::run, this) { }
+
+SolverWorker::~SolverWorker() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+
+    changed.notify_all();
+    thread.join();
+}
+
+long long SolverWorker::submit(const std::vector<Component*>& components) {
+    // Copy the circuit before taking the lock, so the worker is not held up
+    Job copy;
+    copy.types.reserve(components.size());
+    copy.points.reserve(4 * components.size());
+    copy.values.reserve(components.size());
+
+    for (const Component* component : components) {
+        copy.types.push_back(component->type);
+        copy.points.push_back(component->positive->x);
+        copy.points.push_back(component->positive->y);
+        copy.points.push_back(component->negative->x);
+        copy.points.push_back(component->negative->y);
+        copy.values.push_back(component->value);
+    }
+
+    long long submitted;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        submitted = copy.version = ++version;
+
+        // Replaces any job that has not been started
+        job = std::move(copy);
+        hasJob = true;
+
+        // A result for an older version is stale now
+        hasResult = false;
+    }
+
+    changed.notify_all();
+    return submitted;
+}
+
+bool SolverWorker::waitForResult(int milliseconds) {
+    std::unique_lock<std::mutex> lock(mutex);
+    return changed.wait_for(lock, std::chrono::milliseconds(milliseconds),
+                            [this]() { return hasResult; });
+}
+
+bool SolverWorker::takeResult(SolveResult& taken) {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (!hasResult)
+        return false;
+
+    taken = std::move(result);
+    hasResult = false;
+    return true;
+}
+
+void SolverWorker::run() {
+    std::unique_lock<std::mutex> lock(mutex);
+
+    while (true) {
+        changed.wait(lock, [this]() { return stopping || hasJob; });
+        if (stopping)
+            return;
+
+        Job current = std::move(job);
+        hasJob = false;
+
+        lock.unlock();
+        SolveResult solved = solve(current);
+        lock.lock();
+
+        // Publish the result, unless a newer job was submitted while it was
+        // being solved
+        if (current.version == version) {
+            result = std::move(solved);
+            hasResult = true;
+            changed.notify_all();
+        }
+    }
+}
+
+SolveResult SolverWorker::solve(const Job& current) {
+    SolveResult solved;
+    solved.version = current.version;
+
+    std::size_t count = current.types.size();
+
+    // Only the values can differ from the kept circuit, so update them in
+    // place. Else, build the circuit again; the solver's stored system refers
+    // to the old components, so it is discarded.
+    if (circuit && current.types == circuitTypes && current.points == circuitPoints) {
+        for (std::size_t i = 0; i < count; i++)
+            circuit->getComponents()[i]->value = current.values[i];
+    } else {
+        solver.reset();
+        circuit.reset(new Circuit());
+
+        for (std::size_t i = 0; i < count; i++) {
+            circuit->addComponent("", current.types[i],
+                                  current.points[4 * i], current.points[4 * i + 1],
+                                  current.points[4 * i + 2], current.points[4 * i + 3],
+                                  current.values[i]);
+        }
+
+        circuitTypes = current.types;
+        circuitPoints = current.points;
+    }
+
+    try {
+        solver.solve(circuit->getSpots(), circuit->getComponents());
+    } catch (...) {
+        solved.error = true;
+
+        // The solver may have been left part way through an update
+        solver.reset();
+        return solved;
+    }
+
+    solved.voltages.reserve(count);
+    solved.currents.reserve(count);
+
+    for (const Component* component : circuit->getComponents()) {
+        solved.voltages.push_back(component->voltageDrop);
+        solved.currents.push_back(component->currentThrough);
+    }
+
+    return solved;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SolverWorker.h
+    File Description:   Declares the SolveResult struct and the SolverWorker
+                        class. A SolverWorker solves circuits on a background
+                        thread, so the window stays responsive while a large
+                        circuit is solved. Each solve works on a copy of the
+                        circuit taken when it was submitted, and is numbered
+                        with a version. Submitting a new circuit supersedes
+                        any older one that has not finished yet.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <condition_variable>  // condition_variable class
+#include <memory>              // unique_ptr class
+#include <mutex>               // mutex class
+#include <thread>              // thread class
+#include <vector>              // vector class
+#include "Circuit.h"
+#include "Component.h"
+#include "ComponentTypes.h"
+#include "Solver.h"
+
+/**
+    The result of solving one version of a circuit.
+*/
+struct SolveResult {
+    // The version returned by SolverWorker::submit() for the circuit
+    long long version = 0;
+
+    // Whether solving the circuit threw an error. If so, the voltages and
+    // currents are not set.
+    bool error = false;
+
+    // The voltage drop across and current through each component, in the
+    // order they were submitted in
+    std::vector<double> voltages,
+                        currents;
+};
+
+class SolverWorker {
+    private:
+        // A copy of a circuit, as it was when it was submitted
+        struct Job {
+            long long version = 0;
+
+            std::vector<const ComponentType*> types;
+
+            // The positive and negative lattice points of each component,
+            // four coordinates per component
+            std::vector<int> points;
+
+            std::vector<double> values;
+        };
+
+        std::mutex mutex;
+
+        // Signalled when a job is submitted, a result is published, or the
+        // worker is stopped
+        std::condition_variable changed;
+
+        // The newest job that has not been started yet, if hasJob is set
+        Job job;
+        bool hasJob = false;
+
+        // The newest finished result that has not been taken yet, if
+        // hasResult is set
+        SolveResult result;
+        bool hasResult = false;
+
+        // The version of the newest job submitted
+        long long version = 0;
+
+        bool stopping = false;
+
+        // Only used by the worker thread. The circuit of the last job is
+        // kept, so a job with the same topology only changes its values and
+        // the solver can update its factorization instead of starting over.
+        std::unique_ptr<Circuit> circuit;
+        std::vector<const ComponentType*> circuitTypes;
+        std::vector<int> circuitPoints;
+        Solver solver;
+
+        std::thread thread;
+
+        /**
+            Description:   Takes jobs and solves them until the worker is
+                           stopped. Runs on the worker thread.
+            Return:        void
+            Precondition:  Only called once, by the constructor's thread.
+            Postcondition: Every job that was not superseded will have been
+                           solved and its result published.
+        */
+        void run();
+
+        /**
+            Description:   Solves the circuit of a job.
+            Return:        SolveResult
+            Precondition:  Called on the worker thread.
+            Postcondition: The result for the job's version is returned.
+        */
+        SolveResult solve(const Job&);
+
+    public:
+        /**
+            Description:   Initializes a SolverWorker and starts its thread.
+            Return:        None
+            Precondition:  None
+            Postcondition: A SolverWorker with no jobs is returned.
+        */
+        SolverWorker();
+
+        // The thread refers to this object, so it cannot be copied or moved
+        SolverWorker(const SolverWorker&) = delete;
+        SolverWorker& operator =(const SolverWorker&) = delete;
+
+        /**
+            Description:   Stops the worker thread.
+            Return:        None
+            Precondition:  This object exists.
+            Postcondition: Jobs that have not been started are dropped. If a
+                           job is being solved, waits for it to finish.
+        */
+        ~SolverWorker();
+
+        /**
+            Description:   Copies the components and queues the copy to be
+                           solved.
+            Return:        long long
+            Precondition:  Every component is connected to two spots.
+            Postcondition: The version of the copy is returned. It is higher
+                           than the version of every earlier submission, and
+                           any earlier submission that has not finished will
+                           not produce a result. The components are not
+                           modified.
+        */
+        long long submit(const std::vector<Component*>&);
+
+        /**
+            Description:   Waits until a result is ready to be taken, or until
+                           a number of milliseconds have passed.
+            Return:        bool
+            Precondition:  This object exists.
+            Postcondition: Returns true if a result is ready.
+        */
+        bool waitForResult(int);
+
+        /**
+            Description:   Takes the newest result, if there is one.
+            Return:        bool
+            Precondition:  This object exists.
+            Postcondition: If a result was ready, it is moved into the
+                           argument and true is returned. Else, the argument
+                           is not modified and false is returned.
+        */
+        bool takeResult(SolveResult&);
+};
\ No newline at end of file
@@ -0,0 +1,533 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SparseLU.cpp
+    File Description:   Implements the LUSymbolic struct and the SparseLU
+                        class. The factorization is a left-looking
+                        (Gilbert-Peierls) LU with partial pivoting, applied
+                        after a minimum degree ordering of the matrix's
+                        symmetrized pattern.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // sort, unique, max, remove_if
+#include <cfloat>         // DBL_EPSILON
+#include <cmath>          // fabs, sqrt
+#include <stdexcept>      // runtime_error
+#include <utility>        // move
+#include "SparseLU.h"
+
+namespace {
+    // A candidate on the diagonal is preferred as the pivot as long as it is
+    // at least this fraction of the largest candidate in its column. This
+    // keeps the pivots close to the fill-reducing ordering.
+    const double DIAGONAL_PIVOT_TOLERANCE = 0.001;
+
+    // A variable adjacent to more than DENSE_FACTOR * sqrt(n) others (and at
+    // least MIN_DENSE_DEGREE), such as a node every load returns to, joins
+    // nearly every clique. Updating it at every step would make the ordering
+    // quadratic, so it is left out and eliminated last, as AMD does.
+    const double DENSE_FACTOR = 10.0;
+    const int MIN_DENSE_DEGREE = 16;
+
+    /**
+        Description:   Computes an approximate minimum degree ordering of the
+                       pattern of A + A^T. Eliminated nodes are kept as
+                       "elements" (the cliques they would have formed) rather
+                       than adding every fill edge to the graph, so the graph
+                       never grows past the size of the original matrix.
+                       Dense variables are ordered last (see DENSE_FACTOR).
+        Return:        vector<int>
+        Precondition:  The matrix is square.
+        Postcondition: A permutation of the columns is returned. The matrix
+                       will not be modified.
+    */
+    std::vector<int> minimumDegreeOrdering(const SparseMatrix& matrix) {
+        const int n = matrix.cols;
+
+        // vars[i] holds the variables adjacent to variable i, elems[i] the
+        // elements adjacent to it. Once a variable is eliminated it becomes
+        // an element, and members[e] holds the variables in its clique.
+        std::vector<std::vector<int>> vars(n),
+                                      elems(n),
+                                      members(n);
+
+        for (int j = 0; j < n; j++) {
+            for (int p = matrix.colPtr[j]; p < matrix.colPtr[j + 1]; p++) {
+                int i = matrix.rowIdx[p];
+                if (i != j) {
+                    vars[i].push_back(j);
+                    vars[j].push_back(i);
+                }
+            }
+        }
+
+        for (std::vector<int>& a : vars) {
+            std::sort(a.begin(), a.end());
+            a.erase(std::unique(a.begin(), a.end()), a.end());
+        }
+
+        // Set the dense variables aside. They are marked as eliminated, so
+        // they are never added to a clique.
+        const int denseDegree = std::max(MIN_DENSE_DEGREE, int(DENSE_FACTOR * std::sqrt(double(n))));
+        std::vector<char> eliminated(n, false),
+                          absorbed(n, false);
+        std::vector<int> dense;
+
+        for (int i = 0; i < n; i++) {
+            if (int(vars[i].size()) > denseDegree) {
+                eliminated[i] = true;
+                dense.push_back(i);
+            }
+        }
+
+        if (!dense.empty()) {
+            for (int i = 0; i < n; i++) {
+                std::vector<int>& a = vars[i];
+
+                if (eliminated[i]) {
+                    std::vector<int>().swap(a);
+                    continue;
+                }
+
+                a.erase(std::remove_if(a.begin(), a.end(), [&](int v) { return eliminated[v] != 0; }),
+                        a.end());
+            }
+        }
+
+        // Variables are kept in doubly linked lists bucketed by degree so the
+        // variable of minimum degree can be found and moved in constant time.
+        std::vector<int> head(n + 1, -1),
+                         next(n, -1),
+                         prev(n, -1),
+                         degree(n),
+                         inPivot(n, -1),
+                         external(n, -1),
+                         externalStamp(n, -1),
+                         order;
+        order.reserve(n);
+
+        auto insert = [&](int i) {
+            int d = degree[i];
+            prev[i] = -1;
+            next[i] = head[d];
+            if (head[d] != -1)
+                prev[head[d]] = i;
+            head[d] = i;
+        };
+
+        auto remove = [&](int i) {
+            if (prev[i] != -1)
+                next[prev[i]] = next[i];
+            else
+                head[degree[i]] = next[i];
+            if (next[i] != -1)
+                prev[next[i]] = prev[i];
+        };
+
+        for (int i = 0; i < n; i++) {
+            if (eliminated[i])
+                continue;
+
+            degree[i] = int(vars[i].size());
+            insert(i);
+        }
+
+        int minDegree = 0;
+        const int sparseCount = n - int(dense.size());
+
+        for (int k = 0; k < sparseCount; k++) {
+            while (head[minDegree] == -1)
+                minDegree++;
+
+            int pivot = head[minDegree];
+            remove(pivot);
+            order.push_back(pivot);
+            eliminated[pivot] = true;
+
+            // The new element's clique is every variable adjacent to the
+            // pivot, either directly or through one of its elements. Those
+            // elements are contained in the new one, so they are absorbed.
+            std::vector<int>& clique = members[pivot];
+
+            for (int v : vars[pivot]) {
+                if (!eliminated[v] && inPivot[v] != k) {
+                    inPivot[v] = k;
+                    clique.push_back(v);
+                }
+            }
+
+            for (int e : elems[pivot]) {
+                if (absorbed[e])
+                    continue;
+
+                for (int v : members[e]) {
+                    if (!eliminated[v] && inPivot[v] != k) {
+                        inPivot[v] = k;
+                        clique.push_back(v);
+                    }
+                }
+
+                absorbed[e] = true;
+                std::vector<int>().swap(members[e]);
+            }
+
+            std::vector<int>().swap(vars[pivot]);
+            std::vector<int>().swap(elems[pivot]);
+
+            // For every other element touching the clique, count how many of
+            // its variables are outside of the clique.
+            for (int i : clique) {
+                for (int e : elems[i]) {
+                    if (absorbed[e])
+                        continue;
+                    if (externalStamp[e] != k) {
+                        externalStamp[e] = k;
+                        external[e] = int(members[e].size());
+                    }
+                    external[e]--;
+                }
+            }
+
+            const int remaining = sparseCount - k - 1,
+                      cliqueSize = int(clique.size());
+
+            for (int i : clique) {
+                remove(i);
+
+                // Drop absorbed elements, and elements entirely inside the
+                // new clique, which are absorbed as well.
+                std::vector<int>& e = elems[i];
+                int d = cliqueSize - 1,
+                    count = 0;
+
+                for (int q = 0; q < int(e.size()); q++) {
+                    int elem = e[q];
+                    if (absorbed[elem])
+                        continue;
+                    if (external[elem] == 0) {
+                        absorbed[elem] = true;
+                        std::vector<int>().swap(members[elem]);
+                        continue;
+                    }
+
+                    e[count++] = elem;
+                    d += external[elem];
+                }
+
+                e.resize(count);
+                e.push_back(pivot);
+
+                // Variables in the clique are now reached through the new
+                // element, so they are removed from the adjacency list.
+                std::vector<int>& a = vars[i];
+                count = 0;
+
+                for (int v : a) {
+                    if (!eliminated[v] && inPivot[v] != k)
+                        a[count++] = v;
+                }
+
+                a.resize(count);
+                d += count;
+
+                degree[i] = std::min(d, remaining);
+                insert(i);
+                minDegree = std::min(minDegree, degree[i]);
+            }
+        }
+
+        order.insert(order.end(), dense.begin(), dense.end());
+
+        return order;
+    }
+}
+
+bool LUSymbolic::matches(const SparseMatrix& matrix) const {
+    return matrix.rows == n && matrix.cols == n &&
+           matrix.colPtr == colPtr && matrix.rowIdx == rowIdx;
+}
+
+void SparseLU::factorize(const SparseMatrix& matrix) {
+    if (matrix.rows != matrix.cols)
+        throw std::runtime_error("SparseLU::factorize: Matrix is not square");
+
+    factorize(matrix, minimumDegreeOrdering(matrix));
+}
+
+void SparseLU::factorize(const SparseMatrix& matrix, std::vector<int> ordering) {
+    // The pattern is built into a new symbolic factorization, which is only
+    // shared once it is complete
+    std::shared_ptr<LUSymbolic> analysis = std::make_shared<LUSymbolic>();
+    symbolic = nullptr;
+
+    const int n = matrix.cols;
+    analysis->n = n;
+    analysis->colPtr = matrix.colPtr;
+    analysis->rowIdx = matrix.rowIdx;
+    analysis->colPerm = std::move(ordering);
+    analysis->rowPerm.assign(n, -1);
+
+    const std::vector<int>& colPerm = analysis->colPerm;
+    std::vector<int>& rowPerm = analysis->rowPerm;
+    std::vector<int>& lColPtr = analysis->lColPtr;
+    std::vector<int>& lRowIdx = analysis->lRowIdx;
+    std::vector<int>& uColPtr = analysis->uColPtr;
+    std::vector<int>& uRowIdx = analysis->uRowIdx;
+
+    lColPtr.assign(n + 1, 0);
+    uColPtr.assign(n + 1, 0);
+    lRowIdx.clear();
+    lValues.clear();
+    uRowIdx.clear();
+    uValues.clear();
+    lRowIdx.reserve(2 * matrix.nonZeros() + n);
+    lValues.reserve(2 * matrix.nonZeros() + n);
+    uRowIdx.reserve(2 * matrix.nonZeros() + n);
+    uValues.reserve(2 * matrix.nonZeros() + n);
+
+    // Pivots smaller than this are treated as zero, meaning the matrix is
+    // singular (eg: a floating section of the circuit).
+    double maxAbs = 0.0;
+    for (double value : matrix.values)
+        maxAbs = std::max(maxAbs, fabs(value));
+    const double singularTolerance = maxAbs * n * DBL_EPSILON;
+
+    std::vector<double> x(n, 0.0);
+    std::vector<int> reach(n),
+                     stack(n),
+                     position(n),
+                     marker(n, -1);
+
+    for (int k = 0; k < n; k++) {
+        int col = colPerm[k],
+            top = n;
+
+        lColPtr[k] = int(lRowIdx.size());
+        uColPtr[k] = int(uRowIdx.size());
+
+        // Find every row that will be nonzero in column k by following the
+        // already computed columns of L from each nonzero in the original
+        // column. A depth first search leaves them in topological order in
+        // reach[top..n-1].
+        for (int p = matrix.colPtr[col]; p < matrix.colPtr[col + 1]; p++) {
+            int start = matrix.rowIdx[p];
+            if (marker[start] == k)
+                continue;
+
+            int depth = 0;
+            stack[0] = start;
+
+            while (depth >= 0) {
+                int j = stack[depth],
+                    pivotCol = rowPerm[j];
+
+                if (marker[j] != k) {
+                    marker[j] = k;
+                    position[depth] = pivotCol < 0 ? 0 : lColPtr[pivotCol] + 1;
+                }
+
+                int end = pivotCol < 0 ? 0 : lColPtr[pivotCol + 1];
+                bool done = true;
+
+                for (int q = position[depth]; q < end; q++) {
+                    int i = lRowIdx[q];
+                    if (marker[i] != k) {
+                        position[depth] = q + 1;
+                        stack[++depth] = i;
+                        done = false;
+                        break;
+                    }
+                }
+
+                if (done) {
+                    depth--;
+                    reach[--top] = j;
+                }
+            }
+        }
+
+        // Solve L * x = A(:, col) using the rows found above
+        for (int p = matrix.colPtr[col]; p < matrix.colPtr[col + 1]; p++)
+            x[matrix.rowIdx[p]] = matrix.values[p];
+
+        for (int r = top; r < n; r++) {
+            int j = reach[r],
+                pivotCol = rowPerm[j];
+            if (pivotCol < 0)
+                continue;
+
+            double xj = x[j];
+            for (int p = lColPtr[pivotCol] + 1; p < lColPtr[pivotCol + 1]; p++)
+                x[lRowIdx[p]] -= lValues[p] * xj;
+        }
+
+        // Rows that have already been pivoted on go into U. The largest of
+        // the remaining rows becomes the pivot.
+        int pivotRow = -1;
+        double largest = -1.0;
+
+        for (int r = top; r < n; r++) {
+            int i = reach[r];
+
+            if (rowPerm[i] < 0) {
+                if (fabs(x[i]) > largest) {
+                    largest = fabs(x[i]);
+                    pivotRow = i;
+                }
+            } else {
+                uRowIdx.push_back(rowPerm[i]);
+                uValues.push_back(x[i]);
+            }
+        }
+
+        if (pivotRow == -1 || largest <= singularTolerance)
+            throw std::runtime_error("SparseLU::factorize: Matrix is singular");
+
+        if (rowPerm[col] < 0 && marker[col] == k &&
+            fabs(x[col]) >= largest * DIAGONAL_PIVOT_TOLERANCE)
+            pivotRow = col;
+
+        double pivot = x[pivotRow];
+        uRowIdx.push_back(k);
+        uValues.push_back(pivot);
+        rowPerm[pivotRow] = k;
+
+        lRowIdx.push_back(pivotRow);
+        lValues.push_back(1.0);
+
+        for (int r = top; r < n; r++) {
+            int i = reach[r];
+            if (rowPerm[i] < 0) {
+                lRowIdx.push_back(i);
+                lValues.push_back(x[i] / pivot);
+            }
+            x[i] = 0.0;
+        }
+    }
+
+    lColPtr[n] = int(lRowIdx.size());
+    uColPtr[n] = int(uRowIdx.size());
+
+    // L was built using original row indices; renumber them to pivot order
+    for (int& row : lRowIdx)
+        row = rowPerm[row];
+
+    symbolic = analysis;
+}
+
+bool SparseLU::refactorize(const SparseMatrix& matrix, std::shared_ptr<const LUSymbolic> analysis) {
+    if (!analysis->matches(matrix)) {
+        factorize(matrix);
+        return false;
+    }
+
+    symbolic = analysis;
+
+    const int n = analysis->n;
+    const std::vector<int>& colPerm = analysis->colPerm;
+    const std::vector<int>& rowPerm = analysis->rowPerm;
+    const std::vector<int>& lColPtr = analysis->lColPtr;
+    const std::vector<int>& lRowIdx = analysis->lRowIdx;
+    const std::vector<int>& uColPtr = analysis->uColPtr;
+    const std::vector<int>& uRowIdx = analysis->uRowIdx;
+
+    lValues.resize(lRowIdx.size());
+    uValues.resize(uRowIdx.size());
+
+    double maxAbs = 0.0;
+    for (double value : matrix.values)
+        maxAbs = std::max(maxAbs, fabs(value));
+    const double singularTolerance = maxAbs * n * DBL_EPSILON;
+
+    // x is indexed by the pivot order of the rows, which is how the stored
+    // pattern refers to them
+    std::vector<double> x(n, 0.0);
+
+    for (int k = 0; k < n; k++) {
+        int col = colPerm[k];
+
+        for (int p = matrix.colPtr[col]; p < matrix.colPtr[col + 1]; p++)
+            x[rowPerm[matrix.rowIdx[p]]] = matrix.values[p];
+
+        // Solve L * x = A(:, col). The entries of U are stored in the order
+        // they were eliminated in, so each is final by the time it is read.
+        for (int p = uColPtr[k]; p < uColPtr[k + 1] - 1; p++) {
+            int j = uRowIdx[p];
+            double xj = x[j];
+
+            uValues[p] = xj;
+            x[j] = 0.0;
+
+            for (int q = lColPtr[j] + 1; q < lColPtr[j + 1]; q++)
+                x[lRowIdx[q]] -= lValues[q] * xj;
+        }
+
+        // The stored pivot must still pass the test it was chosen with,
+        // otherwise the matrix is factored again with fresh pivots.
+        double pivot = x[k],
+               largest = fabs(pivot);
+        x[k] = 0.0;
+
+        for (int q = lColPtr[k] + 1; q < lColPtr[k + 1]; q++)
+            largest = std::max(largest, fabs(x[lRowIdx[q]]));
+
+        if (fabs(pivot) <= singularTolerance ||
+            fabs(pivot) < largest * DIAGONAL_PIVOT_TOLERANCE) {
+            factorize(matrix, colPerm);
+            return false;
+        }
+
+        uValues[uColPtr[k + 1] - 1] = pivot;
+        lValues[lColPtr[k]] = 1.0;
+
+        for (int q = lColPtr[k] + 1; q < lColPtr[k + 1]; q++) {
+            lValues[q] = x[lRowIdx[q]] / pivot;
+            x[lRowIdx[q]] = 0.0;
+        }
+    }
+
+    return true;
+}
+
+void SparseLU::solve(std::vector<double>& b) const {
+    const int n = symbolic->n;
+    const std::vector<int>& colPerm = symbolic->colPerm;
+    const std::vector<int>& rowPerm = symbolic->rowPerm;
+    const std::vector<int>& lColPtr = symbolic->lColPtr;
+    const std::vector<int>& lRowIdx = symbolic->lRowIdx;
+    const std::vector<int>& uColPtr = symbolic->uColPtr;
+    const std::vector<int>& uRowIdx = symbolic->uRowIdx;
+
+    std::vector<double> y(n);
+
+    for (int i = 0; i < n; i++)
+        y[rowPerm[i]] = b[i];
+
+    // Forward substitution with the unit lower triangular factor
+    for (int k = 0; k < n; k++) {
+        double yk = y[k];
+        for (int p = lColPtr[k] + 1; p < lColPtr[k + 1]; p++)
+            y[lRowIdx[p]] -= lValues[p] * yk;
+    }
+
+    // Back substitution with the upper triangular factor
+    for (int k = n - 1; k >= 0; k--) {
+        y[k] /= uValues[uColPtr[k + 1] - 1];
+
+        double yk = y[k];
+        for (int p = uColPtr[k]; p < uColPtr[k + 1] - 1; p++)
+            y[uRowIdx[p]] -= uValues[p] * yk;
+    }
+
+    for (int k = 0; k < n; k++)
+        b[colPerm[k]] = y[k];
+}
+
+const std::shared_ptr<const LUSymbolic>& SparseLU::getSymbolic() const {
+    return symbolic;
+}
+
+int SparseLU::factorNonZeros() const {
+    return int(lValues.size() + uValues.size());
+}
\ No newline at end of file
@@ -0,0 +1,156 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SparseLU.h
+    File Description:   Declares the LUSymbolic struct and the SparseLU class.
+                        SparseLU factors a square SparseMatrix into sparse
+                        lower and upper triangular factors so that the system
+                        can be solved without ever forming a dense matrix or
+                        an inverse. The pattern of the factors is kept in an
+                        LUSymbolic, so matrices with the same pattern can skip
+                        straight to computing the values.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <memory>          // shared_ptr class
+#include <vector>          // vector class
+#include "SparseMatrix.h"
+
+/**
+    The part of a factorization that only depends on the matrix's pattern:
+    the fill-reducing ordering, the pivot order and the pattern of the L and U
+    factors. It is never modified once built, so it can be shared by any
+    number of SparseLU objects factoring matrices with the same pattern.
+*/
+struct LUSymbolic {
+    int n = 0;
+
+    // The pattern of the matrix that was analyzed, in the same form as a
+    // SparseMatrix
+    std::vector<int> colPtr,
+                     rowIdx;
+
+    // Fill-reducing ordering. Column k of the factors corresponds to column
+    // colPerm[k] of the original matrix.
+    std::vector<int> colPerm;
+
+    // Row pivoting. Row i of the original matrix is row rowPerm[i] of the
+    // factors.
+    std::vector<int> rowPerm;
+
+    // Unit lower triangular factor, stored by column. The unit diagonal is
+    // stored as the first entry of each column.
+    std::vector<int> lColPtr,
+                     lRowIdx;
+
+    // Upper triangular factor, stored by column. The diagonal is stored as
+    // the last entry of each column, and the other entries are stored in the
+    // order they must be eliminated in.
+    std::vector<int> uColPtr,
+                     uRowIdx;
+
+    /**
+        Description:   Determines whether a matrix has the pattern that was
+                       analyzed.
+        Return:        bool
+        Precondition:  This object exists.
+        Postcondition: Returns true if the matrix has the same size and the
+                       same stored entries, false otherwise. This object and
+                       the matrix will not be modified.
+    */
+    bool matches(const SparseMatrix&) const;
+};
+
+class SparseLU {
+    private:
+        std::shared_ptr<const LUSymbolic> symbolic;
+
+        // Values of the L and U factors, in the order of the entries of the
+        // symbolic factorization
+        std::vector<double> lValues,
+                            uValues;
+
+        /**
+            Description:   Factors the matrix using partial pivoting, with the
+                           columns taken in the provided order.
+            Return:        void
+            Precondition:  The matrix is square, and the ordering is a
+                           permutation of its columns.
+            Postcondition: A new symbolic factorization and the values of the
+                           factors will be stored in this object. Throws a
+                           runtime_error if the matrix is singular.
+        */
+        void factorize(const SparseMatrix&, std::vector<int>);
+
+    public:
+        /**
+            Description:   Initializes an empty SparseLU object.
+            Return:        None
+            Precondition:  None
+            Postcondition: A SparseLU object with no factors is returned.
+        */
+        SparseLU() = default;
+
+        /**
+            Description:   Computes a fill-reducing ordering for the matrix
+                           and factors it using partial pivoting.
+            Return:        void
+            Precondition:  This object exists, and the matrix is square.
+            Postcondition: The factors of the matrix will be stored in this
+                           object, along with a new symbolic factorization.
+                           The matrix will not be modified. Throws a
+                           runtime_error if the matrix is singular.
+        */
+        void factorize(const SparseMatrix&);
+
+        /**
+            Description:   Factors the matrix reusing the ordering, pivots and
+                           pattern of an existing symbolic factorization, so
+                           only the numeric values are computed. If a reused
+                           pivot turns out to be too small, the matrix is
+                           factored again with partial pivoting, keeping only
+                           the ordering.
+            Return:        bool
+            Precondition:  This object exists, and the symbolic factorization
+                           has been built.
+            Postcondition: The factors of the matrix will be stored in this
+                           object. Returns true if the symbolic factorization
+                           was reused, false if a new one had to be built (see
+                           getSymbolic()). Throws a runtime_error if the matrix
+                           is singular.
+        */
+        bool refactorize(const SparseMatrix&, std::shared_ptr<const LUSymbolic>);
+
+        /**
+            Description:   Solves A * x = b in place using the stored factors.
+            Return:        void
+            Precondition:  A factorization has completed successfully, and the
+                           vector has one entry per matrix row.
+            Postcondition: The vector will hold the solution x. This object
+                           will not be modified.
+        */
+        void solve(std::vector<double>&) const;
+
+        /**
+            Description:   Returns the symbolic factorization the stored
+                           factors were computed with.
+            Return:        shared_ptr<const LUSymbolic>
+            Precondition:  This object exists.
+            Postcondition: The symbolic factorization is returned, or nullptr
+                           if nothing has been factored. This object will not
+                           be modified.
+        */
+        const std::shared_ptr<const LUSymbolic>& getSymbolic() const;
+
+        /**
+            Description:   Returns the number of entries stored in the L and U
+                           factors.
+            Return:        int
+            Precondition:  This object exists.
+            Postcondition: The number of entries is returned. This object will
+                           not be modified.
+        */
+        int factorNonZeros() const;
+};
\ No newline at end of file
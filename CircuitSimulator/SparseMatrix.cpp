@@ -0,0 +1,99 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SparseMatrix.cpp
+    File Description:   Implements the TripletMatrix and SparseMatrix structs.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // lower_bound
+#include <stdexcept>      // runtime_error
+#include "SparseMatrix.h"
+
+void SparseMatrix::multiply(const std::vector<double>& x, std::vector<double>& y) const {
+    y.assign(rows, 0.0);
+
+    for (int j = 0; j < cols; j++) {
+        for (int p = colPtr[j]; p < colPtr[j + 1]; p++)
+            y[rowIdx[p]] += values[p] * x[j];
+    }
+}
+
+int SparseMatrix::find(int row, int col) const {
+    // Row indices within a column are sorted, so the entry can be found with
+    // a binary search
+    auto begin = rowIdx.begin() + colPtr[col],
+         end = rowIdx.begin() + colPtr[col + 1];
+    auto it = std::lower_bound(begin, end, row);
+
+    return it != end && *it == row ? int(it - rowIdx.begin()) : -1;
+}
+
+TripletMatrix::TripletMatrix(int rows_, int cols_) {
+    rows = rows_;
+    cols = cols_;
+}
+
+void TripletMatrix::add(int row, int col, double value) {
+    if (row < 0 || row >= rows || col < 0 || col >= cols)
+        throw std::runtime_error("TripletMatrix::add: Entry out of bounds");
+
+    rowIdx.push_back(row);
+    colIdx.push_back(col);
+    values.push_back(value);
+}
+
+SparseMatrix TripletMatrix::compress() const {
+    SparseMatrix matrix;
+    matrix.rows = rows;
+    matrix.cols = cols;
+
+    // Bucket the triplets by row first. Scattering the row-ordered triplets
+    // into their columns afterwards leaves every column sorted by row.
+    std::vector<int> rowPtr(rows + 1, 0);
+    for (int row : rowIdx)
+        rowPtr[row + 1]++;
+    for (int i = 0; i < rows; i++)
+        rowPtr[i + 1] += rowPtr[i];
+
+    std::vector<int> byRow(rowIdx.size());
+    std::vector<int> next(rowPtr.begin(), rowPtr.end() - 1);
+    for (int k = 0; k < int(rowIdx.size()); k++)
+        byRow[next[rowIdx[k]]++] = k;
+
+    // Count the distinct entries in each column. A column's last seen row is
+    // tracked so duplicates (which are now adjacent within a row bucket) are
+    // only counted once.
+    std::vector<int> lastRow(cols, -1);
+    matrix.colPtr.assign(cols + 1, 0);
+    for (int k : byRow) {
+        if (lastRow[colIdx[k]] != rowIdx[k]) {
+            lastRow[colIdx[k]] = rowIdx[k];
+            matrix.colPtr[colIdx[k] + 1]++;
+        }
+    }
+    for (int j = 0; j < cols; j++)
+        matrix.colPtr[j + 1] += matrix.colPtr[j];
+
+    matrix.rowIdx.resize(matrix.colPtr[cols]);
+    matrix.values.resize(matrix.colPtr[cols]);
+
+    // Scatter the entries, summing duplicates into the slot that was written
+    // last for that column.
+    next.assign(matrix.colPtr.begin(), matrix.colPtr.end() - 1);
+    lastRow.assign(cols, -1);
+    for (int k : byRow) {
+        int col = colIdx[k];
+
+        if (lastRow[col] == rowIdx[k]) {
+            matrix.values[next[col] - 1] += values[k];
+        } else {
+            lastRow[col] = rowIdx[k];
+            matrix.rowIdx[next[col]] = rowIdx[k];
+            matrix.values[next[col]] = values[k];
+            next[col]++;
+        }
+    }
+
+    return matrix;
+}
\ No newline at end of file
@@ -0,0 +1,96 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SparseMatrix.h
+    File Description:   Declares the TripletMatrix and SparseMatrix structs.
+                        The TripletMatrix is used to assemble a matrix one
+                        entry at a time, and is then compressed into a
+                        SparseMatrix, which stores only the nonzero entries in
+                        compressed sparse column (CSC) form.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <vector>   // vector class, .push_back(), .reserve()
+
+struct SparseMatrix {
+    int rows = 0,
+        cols = 0;
+
+    // Column j holds the entries colPtr[j] through colPtr[j + 1] - 1 of the
+    // rowIdx and values vectors. Row indices within a column are sorted.
+    std::vector<int> colPtr;
+    std::vector<int> rowIdx;
+    std::vector<double> values;
+
+    /**
+        Description:   Returns the number of stored entries.
+        Return:        int
+        Precondition:  This object exists.
+        Postcondition: The number of stored entries is returned. This object
+                       will not be modified.
+    */
+    inline int nonZeros() const { return int(rowIdx.size()); }
+
+    /**
+        Description:   Multiplies this matrix by the vector x and stores the
+                       result in y.
+        Return:        void
+        Precondition:  x has cols entries.
+        Postcondition: y will be resized to rows entries and hold A * x. This
+                       object and x will not be modified.
+    */
+    void multiply(const std::vector<double>&, std::vector<double>&) const;
+
+    /**
+        Description:   Finds the stored entry at the provided row and column.
+        Return:        int
+        Precondition:  The row and column are within the matrix.
+        Postcondition: The index of the entry in the values vector is
+                       returned, or -1 if the entry is not stored. This object
+                       will not be modified.
+    */
+    int find(int, int) const;
+};
+
+struct TripletMatrix {
+    int rows = 0,
+        cols = 0;
+
+    std::vector<int> rowIdx;
+    std::vector<int> colIdx;
+    std::vector<double> values;
+
+    /**
+        Description:   Initializes an empty TripletMatrix with the provided
+                       dimensions.
+        Return:        None
+        Precondition:  None
+        Postcondition: A TripletMatrix with no entries is returned.
+    */
+    TripletMatrix(int, int);
+
+    /**
+        Description:   Adds a value to the entry at the provided row and
+                       column. Entries added to the same position more than
+                       once are summed when the matrix is compressed.
+        Return:        void
+        Precondition:  This object exists.
+        Postcondition: The entry will have been recorded. Throws a
+                       runtime_error if the position is outside the matrix.
+    */
+    void add(int, int, double);
+
+    /**
+        Description:   Compresses the triplets into a SparseMatrix, summing
+                       duplicate entries.
+        Return:        SparseMatrix
+        Precondition:  This object exists.
+        Postcondition: A SparseMatrix holding the sum of all added entries is
+                       returned. Entries that sum to zero are kept so that the
+                       structure only depends on which positions were added.
+                       This object will not be modified.
+    */
+    SparseMatrix compress() const;
+};
\ No newline at end of file
@@ -0,0 +1,508 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SpiceFile.cpp
+    File Description:   Implements methods to read and write SPICE netlists.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <cctype>         // tolower, toupper
+#include <cstdint>        // uint32_t, uint64_t
+#include <cstdio>         // snprintf
+#include <cstdlib>        // strtod
+#include <cstring>        // strcmp
+#include <fstream>        // ifstream, ofstream classes
+#include <stdexcept>      // runtime_error
+#include <unordered_map>  // unordered_map class
+#include "DisjointSet.h"
+#include "GridSpot.h"
+#include "SpiceFile.h"
+
+namespace {
+    // Only the first tokens of a card are used; the rest (such as the AC
+    // and transient parts of a source) are skipped
+    const int MAX_TOKENS = 8;
+
+    /**
+        A word of a card, pointing into the card's text.
+    */
+    struct Token {
+        const char* text;
+        std::size_t length;
+    };
+
+    /**
+        Description:   Splits a card into tokens, at whitespace and at the
+                       '=', ',', '(' and ')' separators, and stops at an
+                       inline comment.
+        Return:        int
+        Precondition:  The array has room for MAX_TOKENS tokens.
+        Postcondition: The number of tokens found, up to MAX_TOKENS, is
+                       returned. The tokens point into the card.
+    */
+    int tokenize(const std::string& card, Token* tokens) {
+        auto isSeparator = [](char ch) {
+            return ch == ' ' || ch == '\t' || ch == '\r' || ch == '=' || ch == ',' || ch == '(' || ch == ')';
+        };
+
+        int count = 0;
+        std::size_t i = 0;
+
+        while (count < MAX_TOKENS) {
+            while (i < card.size() && isSeparator(card[i]))
+                i++;
+
+            if (i == card.size() || card[i] == ';' || card[i] == '$')
+                break;
+
+            std::size_t start = i;
+            while (i < card.size() && !isSeparator(card[i]))
+                i++;
+
+            tokens[count++] = { card.data() + start, i - start };
+        }
+
+        return count;
+    }
+
+    /**
+        Description:   Compares a token to a lower case word, ignoring case.
+        Return:        bool
+        Precondition:  The word is lower case.
+        Postcondition: Returns true if the token is the word.
+    */
+    bool isWord(const Token& token, const char* word) {
+        std::size_t i = 0;
+
+        for (; i < token.length && word[i] != '\0'; i++) {
+            if (tolower((unsigned char)token.text[i]) != word[i])
+                return false;
+        }
+
+        return i == token.length && word[i] == '\0';
+    }
+
+    /**
+        Description:   Parses a SPICE number, such as 4.7k, 10meg or 1e-3V.
+        Return:        bool
+        Precondition:  The token points into a NUL terminated string.
+        Postcondition: Returns false if the token does not start with a
+                       number. Else, the value is set, scaled by the
+                       token's scale factor. Any letters after the scale
+                       factor are taken to be a unit and ignored.
+    */
+    bool parseValue(const Token& token, double& value) {
+        char* end;
+        value = strtod(token.text, &end);
+
+        const char* suffix = end;
+        const char* tokenEnd = token.text + token.length;
+
+        if (suffix == token.text || suffix > tokenEnd)
+            return false;
+
+        auto at = [&](std::size_t offset) {
+            return suffix + offset < tokenEnd ? char(tolower((unsigned char)suffix[offset])) : '\0';
+        };
+
+        if (at(0) == 'm' && at(1) == 'e' && at(2) == 'g') {
+            value *= 1e6;
+        } else if (at(0) == 'm' && at(1) == 'i' && at(2) == 'l') {
+            value *= 25.4e-6;
+        } else {
+            switch (at(0)) {
+                case 't': value *= 1e12;  break;
+                case 'g': value *= 1e9;   break;
+                case 'k': value *= 1e3;   break;
+                case 'm': value *= 1e-3;  break;
+                case 'u': value *= 1e-6;  break;
+                case 'n': value *= 1e-9;  break;
+                case 'p': value *= 1e-12; break;
+                case 'f': value *= 1e-15; break;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+        Maps node names to ids, which are numbered from 0 in the order the
+        names are added. The table is open addressed, and the names are kept
+        back to back in one string, each ending in a NUL character, so adding
+        a node only allocates when the slots or the names have to grow, and
+        looking one up never does.
+    */
+    class NodeTable {
+        private:
+            static const std::size_t INITIAL_SLOTS = 1024;
+
+            struct Slot {
+                std::uint32_t hash;
+
+                // -1 if the slot is empty
+                int id;
+
+                // Where the name starts in names
+                std::size_t offset;
+            };
+
+            std::vector<Slot> slots;
+            std::string names;
+            int count = 0;
+
+            /**
+                Description:   Hashes a name with FNV-1a.
+                Return:        uint32_t
+                Precondition:  None
+                Postcondition: The hash is returned.
+            */
+            static std::uint32_t hash(const char* name, std::size_t length) {
+                std::uint64_t hash = 14695981039346656037ULL;
+
+                for (std::size_t i = 0; i < length; i++) {
+                    hash ^= (unsigned char)name[i];
+                    hash *= 1099511628211ULL;
+                }
+
+                // Fold the high bits in, since only the low bits pick a slot
+                return std::uint32_t(hash ^ (hash >> 32));
+            }
+
+            /**
+                Description:   Doubles the number of slots.
+                Return:        void
+                Precondition:  None
+                Postcondition: Every node will have been moved to a slot in
+                               the new table. Ids are not changed.
+            */
+            void grow() {
+                std::vector<Slot> old(slots.size() * 2, Slot{ 0, -1, 0 });
+                old.swap(slots);
+
+                std::size_t mask = slots.size() - 1;
+                for (const Slot& slot : old) {
+                    if (slot.id < 0)
+                        continue;
+
+                    std::size_t i = slot.hash & mask;
+                    while (slots[i].id >= 0)
+                        i = (i + 1) & mask;
+
+                    slots[i] = slot;
+                }
+            }
+
+        public:
+            /**
+                Description:   Initializes an empty NodeTable.
+                Return:        None
+                Precondition:  None
+                Postcondition: A NodeTable with no nodes is returned.
+            */
+            NodeTable() : slots(INITIAL_SLOTS, Slot{ 0, -1, 0 }) {}
+
+            /**
+                Description:   Returns the id of a node, giving it the next id
+                               if it has not been added before.
+                Return:        int
+                Precondition:  None
+                Postcondition: The node's id is returned.
+            */
+            int getId(const std::string& name) {
+                std::uint32_t nameHash = hash(name.data(), name.size());
+                std::size_t mask = slots.size() - 1;
+                std::size_t i = nameHash & mask;
+
+                for (; slots[i].id >= 0; i = (i + 1) & mask) {
+                    const Slot& slot = slots[i];
+
+                    if (slot.hash == nameHash && strcmp(names.c_str() + slot.offset, name.c_str()) == 0)
+                        return slot.id;
+                }
+
+                int id = count++;
+                slots[i] = { nameHash, id, names.size() };
+                names += name;
+                names += '\0';
+
+                // Keep the table at most half full, so probes stay short
+                if (std::size_t(count) * 2 > slots.size())
+                    grow();
+
+                return id;
+            }
+    };
+
+    /**
+        Reads the cards of one netlist into a circuit. Keeps the node table
+        and the buffers reused for every card.
+    */
+    class Reader {
+        private:
+            Circuit& circuit;
+
+            // The id of every node seen so far, keyed by its lower case name
+            NodeTable nodes;
+            std::string key,
+                        name;
+
+            Token tokens[MAX_TOKENS];
+
+        public:
+            /**
+                Description:   Initializes a Reader for a circuit.
+                Return:        None
+                Precondition:  None
+                Postcondition: A Reader that knows only the ground node is
+                               returned.
+            */
+            explicit Reader(Circuit& circuit) : circuit(circuit) {
+                nodes.getId("0");
+            }
+
+            /**
+                Description:   Returns the id of a node, giving it the next id
+                               if it has not been seen before.
+                Return:        int
+                Precondition:  None
+                Postcondition: The node's id is returned.
+            */
+            int getNode(const Token& token) {
+                key.assign(token.text, token.length);
+                for (char& ch : key)
+                    ch = char(tolower((unsigned char)ch));
+
+                if (key == "gnd")
+                    key = "0";
+
+                return nodes.getId(key);
+            }
+
+            /**
+                Description:   Adds the component described by a card to the
+                               circuit.
+                Return:        bool
+                Precondition:  The card has had its continuation lines
+                               appended.
+                Postcondition: Returns false if the card ends the netlist.
+                               Throws a runtime_error naming the line if the
+                               card cannot be parsed.
+            */
+            bool readCard(const std::string& card, long long lineNumber) {
+                int count = tokenize(card, tokens);
+
+                // Skip blank lines and comments
+                if (count == 0 || tokens[0].text[0] == '*')
+                    return true;
+
+                auto fail = [lineNumber](const std::string& message) {
+                    return std::runtime_error("line " + std::to_string(lineNumber) + ": " + message);
+                };
+
+                name.assign(tokens[0].text, tokens[0].length);
+
+                if (name[0] == '.') {
+                    if (isWord(tokens[0], ".end"))
+                        return false;
+
+                    if (isWord(tokens[0], ".subckt") || isWord(tokens[0], ".include") ||
+                        isWord(tokens[0], ".lib"))
+                        throw fail(name + " is not supported");
+
+                    // Analyses and options do not change the circuit
+                    return true;
+                }
+
+                const ComponentType* type = nullptr;
+                switch (toupper((unsigned char)name[0])) {
+                    case 'R':
+                        type = &RESISTOR;
+                        break;
+                    case 'V':
+                        type = &VSRC;
+                        break;
+                }
+
+                if (type == nullptr)
+                    throw fail("Unsupported element '" + name + "'");
+
+                if (count < 3)
+                    throw fail("Expected two nodes for " + name);
+
+                int positive = getNode(tokens[1]),
+                    negative = getNode(tokens[2]);
+
+                // A resistor needs a value. A source's value may follow "DC",
+                // and is 0 if it only has AC or transient parts.
+                double value = 0.0;
+                int next = 3;
+
+                if (type == &VSRC && next < count && isWord(tokens[next], "dc"))
+                    next++;
+
+                if ((next >= count || !parseValue(tokens[next], value)) && type == &RESISTOR)
+                    throw fail("Expected a value for " + name);
+
+                circuit.addComponent(name, type, positive, 0, negative, 0, value);
+                return true;
+            }
+    };
+
+    /**
+        Description:   Formats a value with as few digits as will read back
+                       as the same value.
+        Return:        const char*
+        Precondition:  The buffer has room for 32 characters.
+        Postcondition: The value is written to the buffer, which is returned.
+    */
+    const char* formatValue(double value, char* buffer) {
+        snprintf(buffer, 32, "%.15g", value);
+
+        if (strtod(buffer, nullptr) != value)
+            snprintf(buffer, 32, "%.17g", value);
+
+        return buffer;
+    }
+
+    /**
+        Description:   Returns the name a component is written with.
+        Return:        string
+        Precondition:  The letter is the SPICE letter of the component's type.
+        Postcondition: The component's own name is returned if it has one that
+                       starts with the letter. Else, the name is made from
+                       the letter and either its own name or the number.
+    */
+    std::string getCardName(char letter, const std::string& name, int number) {
+        if (name.empty())
+            return letter + std::to_string(number);
+
+        if (toupper((unsigned char)name[0]) == letter)
+            return name;
+
+        return letter + name;
+    }
+}
+
+void SpiceFile::read(std::istream& in, Circuit& circuit) {
+    Reader reader(circuit);
+    std::string line,
+                card;
+    long long lineNumber = 0,
+              cardLine = 0;
+
+    // The first line is the title
+    if (!std::getline(in, line))
+        return;
+    lineNumber++;
+
+    // A card is only read once the next line is known not to continue it
+    while (std::getline(in, line)) {
+        lineNumber++;
+
+        if (!line.empty() && line[0] == '+') {
+            card += ' ';
+            card.append(line, 1, std::string::npos);
+            continue;
+        }
+
+        if (!reader.readCard(card, cardLine))
+            return;
+
+        card.swap(line);
+        cardLine = lineNumber;
+    }
+
+    reader.readCard(card, cardLine);
+}
+
+void SpiceFile::load(const std::string& path, Circuit& circuit) {
+    std::ifstream in(path);
+
+    if (!in)
+        throw std::runtime_error("Unable to open " + path);
+
+    read(in, circuit);
+}
+
+void SpiceFile::write(std::ostream& out, const std::vector<Component*>& components,
+                      const std::vector<std::string>& names) {
+    // Number the spots, and join the spots at either end of each wire into
+    // one node
+    std::unordered_map<const GridSpot*, int> spots;
+    spots.reserve(components.size());
+
+    for (const Component* component : components) {
+        spots.emplace(component->positive, int(spots.size()));
+        spots.emplace(component->negative, int(spots.size()));
+    }
+
+    DisjointSet sets(int(spots.size()));
+
+    for (const Component* component : components) {
+        if (component->type == &WIRE)
+            sets.unite(spots[component->positive], spots[component->negative]);
+    }
+
+    // Node 0 is the negative end of the first voltage source, or else the
+    // first spot. Other nodes are numbered as they are first written.
+    std::vector<int> nodeNames(spots.size(), -1);
+    int nextNode = 1,
+        ground = 0;
+
+    for (const Component* component : components) {
+        if (component->type == &VSRC) {
+            ground = spots[component->negative];
+            break;
+        }
+    }
+
+    if (!spots.empty())
+        nodeNames[sets.find(ground)] = 0;
+
+    auto getNodeName = [&](const GridSpot* spot) {
+        int& node = nodeNames[sets.find(spots[spot])];
+        if (node < 0)
+            node = nextNode++;
+
+        return node;
+    };
+
+    int resistors = 0,
+        sources = 0;
+    char value[32];
+
+    out << "* Circuit Simulator netlist" << '\n';
+
+    for (std::size_t i = 0; i < components.size(); i++) {
+        const Component* component = components[i];
+        const std::string& name = i < names.size() ? names[i] : std::string();
+
+        // Wires are written as shared nodes
+        if (component->type == &RESISTOR) {
+            out << getCardName('R', name, ++resistors) << ' '
+                << getNodeName(component->positive) << ' '
+                << getNodeName(component->negative) << ' '
+                << formatValue(component->value, value) << '\n';
+        } else if (component->type == &VSRC) {
+            out << getCardName('V', name, ++sources) << ' '
+                << getNodeName(component->positive) << ' '
+                << getNodeName(component->negative) << " DC "
+                << formatValue(component->value, value) << '\n';
+        }
+    }
+
+    out << ".end" << '\n';
+}
+
+void SpiceFile::save(const std::string& path, const std::vector<Component*>& components,
+                     const std::vector<std::string>& names) {
+    std::ofstream out(path);
+
+    if (!out)
+        throw std::runtime_error("Unable to open " + path);
+
+    write(out, components, names);
+
+    if (!out)
+        throw std::runtime_error("Unable to write " + path);
+}
\ No newline at end of file
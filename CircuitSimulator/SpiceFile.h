@@ -0,0 +1,88 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SpiceFile.h
+    File Description:   Declares methods to read a Circuit from a SPICE
+                        netlist, and to write components out as one. The
+                        first line of a netlist is its title. After that,
+                        lines starting with '*' are comments, lines starting
+                        with '+' continue the previous card, and everything
+                        from a ';' or '$' token on is ignored. Resistor and
+                        voltage source cards are supported:
+
+                            R<name> <node+> <node-> <value>
+                            V<name> <node+> <node-> [DC] <value>
+
+                        Values may end in a SPICE scale factor (f, p, n, u, m,
+                        k, meg, g, t), optionally followed by a unit. Node
+                        names are not case sensitive, and "gnd" is the same
+                        node as "0". A netlist ends at a .end card; other dot
+                        cards are ignored, except .subckt, .include and .lib,
+                        which are not supported. Each node is given its own
+                        lattice point, so the circuit can be solved like any
+                        other.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <istream>      // istream class
+#include <ostream>      // ostream class
+#include <string>       // string class
+#include <vector>       // vector class
+#include "Circuit.h"
+#include "Component.h"
+
+namespace SpiceFile {
+    /**
+        Description:   Reads every card from the stream into the circuit. The
+                       stream is read one line at a time, and the buffers used
+                       for each line are reused, so the memory used does not
+                       grow with the length of the netlist beyond the circuit
+                       itself.
+        Return:        void
+        Precondition:  The stream is open and the circuit has been
+                       initialized.
+        Postcondition: The components described by the netlist will have been
+                       added to the circuit. Throws a runtime_error naming the
+                       offending line if a card cannot be parsed.
+    */
+    void read(std::istream&, Circuit&);
+
+    /**
+        Description:   Opens the netlist at the provided path and reads it into
+                       the circuit.
+        Return:        void
+        Precondition:  The circuit has been initialized.
+        Postcondition: The components described by the netlist will have been
+                       added to the circuit. Throws a runtime_error if the
+                       file cannot be opened or parsed.
+    */
+    void load(const std::string&, Circuit&);
+
+    /**
+        Description:   Writes components out as a netlist. Spots joined by
+                       wires are written as one node, and the node at the
+                       negative end of the first voltage source is node 0. The
+                       names are optional; components without one are
+                       numbered by type.
+        Return:        void
+        Precondition:  Every component is connected to two spots.
+        Postcondition: A card for every resistor and voltage source will have
+                       been written, followed by .end. The components are not
+                       modified.
+    */
+    void write(std::ostream&, const std::vector<Component*>&,
+               const std::vector<std::string>& = std::vector<std::string>());
+
+    /**
+        Description:   Writes components out as a netlist to the file at the
+                       provided path.
+        Return:        void
+        Precondition:  Every component is connected to two spots.
+        Postcondition: The file will have been written. Throws a
+                       runtime_error if it cannot be.
+    */
+    void save(const std::string&, const std::vector<Component*>&,
+              const std::vector<std::string>& = std::vector<std::string>());
+}
\ No newline at end of file
@@ -0,0 +1,233 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Sweep.cpp
+    File Description:   Implements the Sweep class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // max
+#include <atomic>         // atomic class
+#include <cmath>          // pow
+#include <exception>      // exception_ptr, current_exception, rethrow_exception
+#include <map>            // map class
+#include <mutex>          // mutex, lock_guard
+#include <sstream>        // istringstream class
+#include <stdexcept>      // runtime_error
+#include <thread>         // thread class
+#include "Sweep.h"
+
+Sweep::Sweep(const Circuit& circuit, const std::vector<SweepParameter>& parameters_,
+             const std::vector<std::string>& probeNames_) : system(circuit), parameters(parameters_) {
+    const std::vector<Component*>& components = circuit.getComponents();
+
+    // Each component is added to the system once, whether it is swept,
+    // probed or both
+    std::map<int, int> added;
+
+    auto addComponent = [&](const std::string& name) {
+        for (int i = 0; i < int(components.size()); i++) {
+            if (components[i]->type != &WIRE && circuit.getName(i) == name) {
+                if (added.find(i) == added.end())
+                    added[i] = system.addComponent(circuit, i);
+
+                return added[i];
+            }
+        }
+
+        throw std::runtime_error("There is no resistor or voltage source named " + name);
+    };
+
+    for (int p = 0; p < int(parameters.size()); p++) {
+        if (parameters[p].values.empty())
+            throw std::runtime_error("No values given for " + parameters[p].name);
+
+        for (int q = 0; q < p; q++) {
+            if (parameters[q].name == parameters[p].name)
+                throw std::runtime_error(parameters[p].name + " is swept more than once");
+        }
+
+        int component = addComponent(parameters[p].name);
+
+        if (!system.canVary(component))
+            throw std::runtime_error(parameters[p].name + " is in parallel with resistors "
+                                     "too large to sweep");
+
+        parameterComponents.push_back(component);
+        pointCount *= (long long)parameters[p].values.size();
+    }
+
+    if (probeNames_.empty()) {
+        for (int i = 0; i < int(components.size()); i++) {
+            if (components[i]->type != &WIRE)
+                probeNames.push_back(circuit.getName(i));
+        }
+    } else {
+        probeNames = probeNames_;
+    }
+
+    for (const std::string& name : probeNames)
+        probes.push_back(addComponent(name));
+}
+
+void Sweep::solvePoint(long long index, ParametricSystem::Workspace& workspace,
+                       std::vector<double>& values, SweepPoint& point) const {
+    point.index = index;
+    point.values.resize(parameters.size());
+
+    // Decode the index, with the last parameter changing fastest
+    long long rest = index;
+    for (int p = int(parameters.size()) - 1; p >= 0; p--) {
+        const std::vector<double>& parameterValues = parameters[p].values;
+        point.values[p] = parameterValues[rest % (long long)parameterValues.size()];
+        rest /= (long long)parameterValues.size();
+    }
+
+    values.resize(system.getComponentCount());
+    for (int i = 0; i < int(values.size()); i++)
+        values[i] = system.getValue(i);
+
+    for (int p = 0; p < int(parameters.size()); p++)
+        values[parameterComponents[p]] = point.values[p];
+
+    // Some combinations of values cannot be solved (eg: a singular matrix).
+    // The rest of the sweep is still useful.
+    point.solved = system.solve(values, workspace);
+    if (!point.solved)
+        return;
+
+    point.voltages.resize(probes.size());
+    point.currents.resize(probes.size());
+
+    for (int i = 0; i < int(probes.size()); i++)
+        system.getResult(workspace, probes[i], values[probes[i]], point.voltages[i], point.currents[i]);
+}
+
+long long Sweep::getPointCount() const {
+    return pointCount;
+}
+
+const std::vector<SweepParameter>& Sweep::getParameters() const {
+    return parameters;
+}
+
+const std::vector<std::string>& Sweep::getProbeNames() const {
+    return probeNames;
+}
+
+void Sweep::run(int threads, const std::function<void(const SweepPoint&)>& callback) const {
+    if (threads <= 0)
+        threads = std::max(1, int(std::thread::hardware_concurrency()));
+
+    std::atomic<long long> next(0);
+    std::atomic<bool> failed(false);
+
+    // Points can finish out of order. Finished points wait here until every
+    // earlier point has been passed to the callback.
+    std::mutex mutex;
+    std::map<long long, SweepPoint> finished;
+    long long nextToReport = 0;
+    std::exception_ptr error;
+
+    auto worker = [&]() {
+        ParametricSystem::Workspace workspace;
+        std::vector<double> values;
+
+        try {
+            long long index;
+
+            while (!failed && (index = next++) < pointCount) {
+                SweepPoint point;
+                solvePoint(index, workspace, values, point);
+
+                std::lock_guard<std::mutex> lock(mutex);
+                finished.emplace(index, std::move(point));
+
+                while (!finished.empty() && finished.begin()->first == nextToReport) {
+                    callback(finished.begin()->second);
+                    finished.erase(finished.begin());
+                    nextToReport++;
+                }
+            }
+        } catch (...) {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (!error)
+                error = std::current_exception();
+            failed = true;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (int t = 1; t < threads; t++)
+        pool.emplace_back(worker);
+
+    worker();
+
+    for (std::thread& thread : pool)
+        thread.join();
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+SweepParameter Sweep::parseParameter(const std::string& text) {
+    SweepParameter parameter;
+
+    size_t equals = text.find('='),
+           colon = text.find(':', equals);
+
+    if (equals == std::string::npos || equals == 0 || colon == std::string::npos)
+        throw std::runtime_error("Expected <name>=<lin|log|list>:<values>, got " + text);
+
+    parameter.name = text.substr(0, equals);
+
+    std::string kind = text.substr(equals + 1, colon - equals - 1);
+    std::istringstream ss(text.substr(colon + 1));
+    std::string field;
+    std::vector<double> fields;
+
+    // Both forms are lists of numbers, separated by ':' for ranges and ','
+    // for lists
+    char separator = kind == "list" ? ',' : ':';
+
+    while (std::getline(ss, field, separator)) {
+        try {
+            size_t used;
+            fields.push_back(std::stod(field, &used));
+            if (used != field.size())
+                throw std::invalid_argument(field);
+        } catch (const std::exception&) {
+            throw std::runtime_error("Invalid number '" + field + "' in " + text);
+        }
+    }
+
+    if (kind == "list") {
+        if (fields.empty())
+            throw std::runtime_error("Expected at least one value in " + text);
+
+        parameter.values = fields;
+    } else if (kind == "lin" || kind == "log") {
+        if (fields.size() != 3 || fields[2] < 1 || fields[2] != double(int(fields[2])))
+            throw std::runtime_error("Expected <start>:<stop>:<count> in " + text);
+
+        double start = fields[0],
+               stop = fields[1];
+        int count = int(fields[2]);
+
+        if (kind == "log" && (start <= 0.0 || stop <= 0.0))
+            throw std::runtime_error("Logarithmic ranges must be positive in " + text);
+
+        for (int i = 0; i < count; i++) {
+            double t = count == 1 ? 0.0 : double(i) / (count - 1);
+
+            if (kind == "lin")
+                parameter.values.push_back(start + (stop - start) * t);
+            else
+                parameter.values.push_back(start * std::pow(stop / start, t));
+        }
+    } else {
+        throw std::runtime_error("Unknown range type '" + kind + "' in " + text);
+    }
+
+    return parameter;
+}
\ No newline at end of file
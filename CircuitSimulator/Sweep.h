@@ -0,0 +1,148 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         Sweep.h
+    File Description:   Declares the SweepParameter and SweepPoint structs and
+                        the Sweep class. A Sweep solves one circuit for every
+                        combination of values of a set of components. The
+                        circuit's topology is analyzed once (see
+                        ParametricSystem.h), and the points are then solved in
+                        parallel.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <functional>      // function class
+#include <string>          // string class
+#include <vector>          // vector class
+#include "Circuit.h"
+#include "ParametricSystem.h"
+
+/**
+    A component whose value is swept, and the values it takes.
+*/
+struct SweepParameter {
+    std::string name;
+    std::vector<double> values;
+};
+
+/**
+    The result of solving the circuit at one point of a sweep.
+*/
+struct SweepPoint {
+    // Points are numbered from zero, with the last parameter changing
+    // fastest
+    long long index = 0;
+
+    // The value of each parameter at this point
+    std::vector<double> values;
+
+    // Whether the circuit could be solved at this point. If not, the
+    // voltages and currents are not set.
+    bool solved = false;
+
+    // The voltage drop across and current through each probed component
+    std::vector<double> voltages,
+                        currents;
+};
+
+class Sweep {
+    private:
+        ParametricSystem system;
+
+        std::vector<SweepParameter> parameters;
+
+        // The index in the system of the component each parameter sets
+        std::vector<int> parameterComponents;
+
+        // The names and indices in the system of the reported components
+        std::vector<std::string> probeNames;
+        std::vector<int> probes;
+
+        long long pointCount = 1;
+
+        /**
+            Description:   Solves the circuit at one point of the sweep.
+            Return:        void
+            Precondition:  The workspace and value vector belong to the
+                           calling thread.
+            Postcondition: The SweepPoint will hold the results for the point.
+                           The workspace and value vector will have been
+                           overwritten. This object will not be modified.
+        */
+        void solvePoint(long long, ParametricSystem::Workspace&, std::vector<double>&, SweepPoint&) const;
+
+    public:
+        /**
+            Description:   Analyzes the circuit, and prepares to sweep the
+                           provided parameters and report the provided
+                           components.
+            Return:        None
+            Precondition:  The circuit has been initialized, and every
+                           parameter has at least one value.
+            Postcondition: A Sweep object is returned. If no probes are
+                           provided, every resistor and voltage source is
+                           reported. Throws a runtime_error if the circuit is
+                           incomplete or cannot be analyzed, or a name does not
+                           match a resistor or voltage source.
+        */
+        Sweep(const Circuit&, const std::vector<SweepParameter>&, const std::vector<std::string>& = std::vector<std::string>());
+
+        /**
+            Description:   Returns the number of points in the sweep, which is
+                           the product of the number of values of every
+                           parameter.
+            Return:        long long
+            Precondition:  This object exists.
+            Postcondition: The number of points is returned. This object will
+                           not be modified.
+        */
+        long long getPointCount() const;
+
+        /**
+            Description:   Returns the swept parameters.
+            Return:        vector<SweepParameter>
+            Precondition:  This object exists.
+            Postcondition: The parameters are returned. This object will not
+                           be modified.
+        */
+        const std::vector<SweepParameter>& getParameters() const;
+
+        /**
+            Description:   Returns the names of the reported components, in
+                           the order their results appear in a SweepPoint.
+            Return:        vector<string>
+            Precondition:  This object exists.
+            Postcondition: The names are returned. This object will not be
+                           modified.
+        */
+        const std::vector<std::string>& getProbeNames() const;
+
+        /**
+            Description:   Solves every point of the sweep on the provided
+                           number of threads, and passes each result to the
+                           callback. Results are passed in order of their
+                           index as soon as every earlier point has finished.
+            Return:        void
+            Precondition:  This object exists. If the number of threads is not
+                           positive, one thread per core is used.
+            Postcondition: The callback will have been called once per point,
+                           never by two threads at once. Rethrows the first
+                           exception thrown by the callback.
+        */
+        void run(int, const std::function<void(const SweepPoint&)>&) const;
+
+        /**
+            Description:   Parses a parameter of the form name=values, where
+                           values is one of:
+                               lin:start:stop:count   evenly spaced values
+                               log:start:stop:count   logarithmically spaced
+                               list:v1,v2,...         the listed values
+            Return:        SweepParameter
+            Precondition:  None
+            Postcondition: The parameter is returned. Throws a runtime_error
+                           if the string cannot be parsed.
+        */
+        static SweepParameter parseParameter(const std::string&);
+};
\ No newline at end of file
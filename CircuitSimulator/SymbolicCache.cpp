@@ -0,0 +1,111 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SymbolicCache.cpp
+    File Description:   Implements the SymbolicCache class.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include "SymbolicCache.h"
+
+SymbolicCache::SymbolicCache(int capacity_) {
+    capacity = capacity_ < 1 ? 1 : capacity_;
+}
+
+void SymbolicCache::factorize(const SparseMatrix& matrix, SparseLU& lu) {
+    std::uint64_t key = fingerprint(matrix);
+    std::shared_ptr<const LUSymbolic> symbolic = find(key, matrix);
+
+    // The factorization itself runs without holding the lock. If the stored
+    // pivots do not work for this matrix, the new symbolic factorization
+    // replaces the old one.
+    if (symbolic == nullptr) {
+        lu.factorize(matrix);
+        insert(key, lu.getSymbolic());
+    } else if (!lu.refactorize(matrix, symbolic)) {
+        insert(key, lu.getSymbolic());
+    }
+}
+
+std::uint64_t SymbolicCache::fingerprint(const SparseMatrix& matrix) {
+    // FNV-1a over the size and the compressed column pattern
+    std::uint64_t hash = 14695981039346656037ULL;
+
+    auto mix = [&hash](int value) {
+        hash ^= std::uint64_t(std::uint32_t(value));
+        hash *= 1099511628211ULL;
+    };
+
+    mix(matrix.rows);
+    mix(matrix.cols);
+
+    for (int p : matrix.colPtr)
+        mix(p);
+    for (int i : matrix.rowIdx)
+        mix(i);
+
+    return hash;
+}
+
+std::shared_ptr<const LUSymbolic> SymbolicCache::find(std::uint64_t key, const SparseMatrix& matrix) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    // Fingerprints can collide, so the pattern itself is compared as well
+    for (Entry& entry : entries) {
+        if (entry.fingerprint == key && entry.symbolic->matches(matrix)) {
+            entry.lastUse = ++useCount;
+            hits++;
+            return entry.symbolic;
+        }
+    }
+
+    misses++;
+    return nullptr;
+}
+
+void SymbolicCache::insert(std::uint64_t key, std::shared_ptr<const LUSymbolic> symbolic) {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    Entry* slot = nullptr;
+
+    // Replace the entry for the same pattern if there is one
+    for (Entry& entry : entries) {
+        if (entry.fingerprint == key && entry.symbolic->n == symbolic->n &&
+            entry.symbolic->colPtr == symbolic->colPtr &&
+            entry.symbolic->rowIdx == symbolic->rowIdx)
+            slot = &entry;
+    }
+
+    if (slot == nullptr && int(entries.size()) < capacity) {
+        entries.push_back(Entry());
+        slot = &entries.back();
+    } else if (slot == nullptr) {
+        slot = &entries[0];
+        for (Entry& entry : entries) {
+            if (entry.lastUse < slot->lastUse)
+                slot = &entry;
+        }
+    }
+
+    slot->fingerprint = key;
+    slot->symbolic = symbolic;
+    slot->lastUse = ++useCount;
+}
+
+long long SymbolicCache::getHits() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return hits;
+}
+
+long long SymbolicCache::getMisses() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return misses;
+}
+
+void SymbolicCache::clear() {
+    std::lock_guard<std::mutex> lock(mutex);
+    entries.clear();
+    useCount = 0;
+    hits = 0;
+    misses = 0;
+}
\ No newline at end of file
@@ -0,0 +1,124 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         SymbolicCache.h
+    File Description:   Declares the SymbolicCache class. This class keeps the
+                        symbolic factorizations (see SparseLU.h) of recently
+                        factored matrices, keyed by a fingerprint of their
+                        pattern. The pattern of a nodal analysis matrix only
+                        depends on how the nodes are connected, so solving a
+                        circuit again after its values change only needs the
+                        numeric factorization.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#pragma once
+
+#include <cstdint>         // uint64_t
+#include <memory>          // shared_ptr class
+#include <mutex>           // mutex class
+#include <vector>          // vector class
+#include "SparseLU.h"
+#include "SparseMatrix.h"
+
+class SymbolicCache {
+    private:
+        struct Entry {
+            std::uint64_t fingerprint;
+            std::shared_ptr<const LUSymbolic> symbolic;
+
+            // The value of useCount when the entry was last used
+            long long lastUse;
+        };
+
+        // The cache can be shared by several threads
+        mutable std::mutex mutex;
+
+        std::vector<Entry> entries;
+        int capacity;
+        long long useCount = 0;
+
+        long long hits = 0,
+                  misses = 0;
+
+        /**
+            Description:   Finds the symbolic factorization for a matrix, and
+                           counts the lookup as a hit or a miss.
+            Return:        shared_ptr<const LUSymbolic>
+            Precondition:  This object exists.
+            Postcondition: The symbolic factorization is returned, or nullptr
+                           if the matrix's pattern is not in the cache.
+        */
+        std::shared_ptr<const LUSymbolic> find(std::uint64_t, const SparseMatrix&);
+
+        /**
+            Description:   Adds a symbolic factorization to the cache,
+                           replacing the least recently used entry if the
+                           cache is full.
+            Return:        void
+            Precondition:  The symbolic factorization has been built.
+            Postcondition: The symbolic factorization will be in the cache.
+        */
+        void insert(std::uint64_t, std::shared_ptr<const LUSymbolic>);
+
+    public:
+        /**
+            Description:   Initializes an empty SymbolicCache that holds up to
+                           the provided number of entries.
+            Return:        None
+            Precondition:  The capacity is at least one.
+            Postcondition: An empty SymbolicCache object is returned.
+        */
+        SymbolicCache(int = 16);
+
+        /**
+            Description:   Factors a matrix, reusing the symbolic
+                           factorization of an earlier matrix with the same
+                           pattern if there is one in the cache.
+            Return:        void
+            Precondition:  The matrix is square.
+            Postcondition: The LU will hold the factors of the matrix, and its
+                           symbolic factorization will be in the cache. Throws
+                           a runtime_error if the matrix is singular.
+        */
+        void factorize(const SparseMatrix&, SparseLU&);
+
+        /**
+            Description:   Computes a fingerprint of a matrix's size and
+                           pattern. Matrices with the same pattern always have
+                           the same fingerprint.
+            Return:        uint64_t
+            Precondition:  The matrix has been initialized.
+            Postcondition: The fingerprint is returned. The matrix will not be
+                           modified.
+        */
+        static std::uint64_t fingerprint(const SparseMatrix&);
+
+        /**
+            Description:   Returns the number of lookups that found a symbolic
+                           factorization.
+            Return:        long long
+            Precondition:  This object exists.
+            Postcondition: The number of hits is returned. This object will
+                           not be modified.
+        */
+        long long getHits() const;
+
+        /**
+            Description:   Returns the number of lookups that did not find a
+                           symbolic factorization.
+            Return:        long long
+            Precondition:  This object exists.
+            Postcondition: The number of misses is returned. This object will
+                           not be modified.
+        */
+        long long getMisses() const;
+
+        /**
+            Description:   Removes every entry and resets the counters.
+            Return:        void
+            Precondition:  This object exists.
+            Postcondition: The cache will be empty.
+        */
+        void clear();
+};
\ No newline at end of file
@@ -0,0 +1,662 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         bench.cpp
+    File Description:   Entry point for the solver benchmark. Generates
+                        families of circuits (resistor ladders, 2D and 3D
+                        resistor meshes, random sparse graphs, chains of
+                        voltage sources and stars around one hub node) at
+                        sizes from 10 nodes up, times each stage of
+                        Calculator::calculate() on them, and writes the
+                        results as JSON or CSV so they can be compared between
+                        builds. Each case is run in a child process where
+                        the platform allows it, so the peak memory reported
+                        for it is its own. With --factor-target, a case whose
+                        first factorization takes longer than the target is
+                        marked "slow" and the program fails.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // min, max
+#include <chrono>         // steady_clock
+#include <cmath>          // sqrt, cbrt, log, pow, lround
+#include <cstdint>        // uint32_t
+#include <cstring>        // memcpy
+#include <ctime>          // time, strftime, gmtime
+#include <exception>      // exception class
+#include <fstream>        // ofstream
+#include <iostream>       // cout, cerr
+#include <iterator>       // begin, end
+#include <random>         // mt19937, uniform_real_distribution, uniform_int_distribution
+#include <sstream>        // istringstream, ostringstream
+#include <string>         // string class
+#include <vector>         // vector class
+#include "Calculator.h"
+#include "Circuit.h"
+#include "Profiler.h"
+#include "SparseLU.h"
+
+#ifndef _WIN32
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <unistd.h>
+#endif
+
+namespace {
+    // The stages of a cold solve, in the order they are run. "system" is the
+    // whole of Calculator::buildSystem(), which includes the "nodes",
+    // "netlist" and "reduce" stages; those are also timed on their own to
+    // show where the time goes.
+    const char* const PHASES[] = { "generate", "populate", "nodes", "netlist", "reduce", "system",
+                                   "factor", "refactor", "solve", "values" };
+    const int PHASE_COUNT = sizeof(PHASES) / sizeof(PHASES[0]);
+
+    const char* const FAMILIES[] = { "ladder", "mesh2d", "mesh3d", "random", "vchain", "star" };
+
+    struct Result {
+        std::string family;
+        long long size = 0;
+        std::string status;
+
+        int nodes = 0,
+            components = 0,
+            unknowns = 0,
+            nonZeros = 0,
+            factorNonZeros = 0;
+
+        double phases[PHASE_COUNT] = { };
+
+        // The time of the stages Calculator::calculate() runs on a circuit
+        // it has not seen before
+        double total = 0.0;
+
+        // The peak resident memory of the child process that ran the case,
+        // in bytes, or -1 when the case was not run in a child process. The
+        // parent never runs a case, so the memory the child starts with is
+        // small and the same for every case.
+        long long peakMemory = -1;
+    };
+
+    /**
+        Description:   Runs a function and returns how long it took.
+        Return:        double
+        Precondition:  None
+        Postcondition: The time taken is returned, in seconds.
+    */
+    template <class Function>
+    double timeOf(Function function) {
+        auto start = std::chrono::steady_clock::now();
+        function();
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    }
+
+    /**
+        Description:   Builds a circuit of the provided family with about the
+                       provided number of nodes. Node k of a mesh or graph is
+                       placed at an arbitrary lattice point, since components
+                       do not have to connect neighbouring points.
+        Return:        void
+        Precondition:  The circuit is empty, and the family is one of
+                       FAMILIES.
+        Postcondition: The circuit will hold the generated components.
+    */
+    void generate(const std::string& family, long long size, std::uint32_t seed, Circuit& circuit) {
+        std::mt19937 random(seed);
+        std::uniform_real_distribution<double> resistance(1.0, 100.0),
+                                               voltage(1.0, 10.0);
+        int count = 0;
+
+        auto resistor = [&](int x1, int y1, int x2, int y2) {
+            circuit.addComponent("R" + std::to_string(count++), &RESISTOR, x1, y1, x2, y2, resistance(random));
+        };
+
+        auto source = [&](int x1, int y1, int x2, int y2) {
+            circuit.addComponent("V" + std::to_string(count++), &VSRC, x1, y1, x2, y2, voltage(random));
+        };
+
+        const int n = int(std::max(size, 2LL));
+
+        if (family == "ladder") {
+            // Series resistors along the top rail, shunt resistors to a
+            // bottom rail joined by wires
+            for (int i = 0; i + 1 < n; i++) {
+                if (i + 2 < n)
+                    resistor(i, 0, i + 1, 0);
+                resistor(i, 0, i, 1);
+                if (i + 2 < n)
+                    circuit.addComponent("W" + std::to_string(count++), &WIRE, i, 1, i + 1, 1, 0.0);
+            }
+
+            source(0, 0, 0, 1);
+        } else if (family == "mesh2d" || family == "mesh3d") {
+            const bool flat = family == "mesh2d";
+            const int side = std::max(2, int(std::lround(flat ? std::sqrt(double(n)) : std::cbrt(double(n))))),
+                      depth = flat ? 1 : side;
+
+            // Node (x, y, z) is placed at lattice point (x + y * side, z)
+            for (int z = 0; z < depth; z++) {
+                for (int y = 0; y < side; y++) {
+                    for (int x = 0; x < side; x++) {
+                        int px = x + y * side;
+
+                        if (x + 1 < side)
+                            resistor(px, z, px + 1, z);
+                        if (y + 1 < side)
+                            resistor(px, z, px + side, z);
+                        if (z + 1 < depth)
+                            resistor(px, z, px, z + 1);
+                    }
+                }
+            }
+
+            source(side * side - 1, depth - 1, 0, 0);
+        } else if (family == "random") {
+            // A random tree keeps the graph connected, and extra edges bring
+            // the average degree to about four
+            std::vector<int> degree(n, 0);
+
+            auto edge = [&](int a, int b) {
+                resistor(a, 0, b, 0);
+                degree[a]++;
+                degree[b]++;
+            };
+
+            for (int i = 1; i < n; i++)
+                edge(std::uniform_int_distribution<int>(0, i - 1)(random), i);
+
+            std::uniform_int_distribution<int> any(0, n - 1);
+            for (int e = 0; e < n; e++) {
+                int a = any(random),
+                    b = any(random);
+
+                if (a != b)
+                    edge(a, b);
+            }
+
+            // Every spot needs at least two components
+            for (int i = 0; i < n; i++) {
+                if (degree[i] < 2)
+                    edge(i, (i + 1) % n);
+            }
+
+            source(0, 0, n - 1, 0);
+        } else if (family == "vchain") {
+            // A chain of voltage sources in series, with a load resistor from
+            // every junction back to the start of the chain
+            for (int i = 0; i + 1 < n; i++) {
+                source(i + 1, 0, i, 0);
+                resistor(i + 1, 0, 0, 0);
+            }
+        } else {
+            // A chain of resistors along the bottom row, with a spoke from
+            // every node to a hub at (0, 1), like the rail of a supply. The
+            // hub is adjacent to every other node.
+            for (int i = 0; i + 1 < n; i++) {
+                if (i + 2 < n)
+                    resistor(i, 0, i + 1, 0);
+
+                if (i == 0)
+                    source(0, 1, i, 0);
+                else
+                    resistor(i, 0, 0, 1);
+            }
+        }
+    }
+
+    /**
+        Description:   Generates and solves one circuit, timing every stage.
+        Return:        Result
+        Precondition:  The family is one of FAMILIES.
+        Postcondition: The result is returned. Errors are recorded in its
+                       status rather than thrown.
+    */
+    Result runCase(const std::string& family, long long size, std::uint32_t seed) {
+        Result result;
+        result.family = family;
+        result.size = size;
+        result.status = "ok";
+
+        Circuit circuit;
+        double* phase = result.phases;
+
+        try {
+            phase[0] = timeOf([&]() { generate(family, size, seed, circuit); });
+            result.components = int(circuit.getComponents().size());
+
+            std::vector<GridSpot*> populatedSpots;
+            bool complete = false;
+            phase[1] = timeOf([&]() { complete = Calculator::getPopulatedSpots(circuit.getSpots(), populatedSpots); });
+
+            if (!complete) {
+                result.status = "incomplete";
+                return result;
+            }
+
+            Netlist netlist;
+
+            phase[2] = timeOf([&]() {
+                std::vector<int> nodeIds = Calculator::getSpotNodeIds(populatedSpots);
+                for (int i = 0; i < int(populatedSpots.size()); i++)
+                    populatedSpots[i]->node = nodeIds[i];
+            });
+            phase[3] = timeOf([&]() { netlist = Calculator::buildNetlist(populatedSpots); });
+            phase[4] = timeOf([&]() { netlist = Calculator::reduceNodes(netlist); });
+
+            NodalSystem system;
+            phase[5] = timeOf([&]() { system = Calculator::buildSystem(populatedSpots); });
+
+            result.nodes = system.nodeCount;
+            result.unknowns = system.matrix.rows;
+            result.nonZeros = system.matrix.nonZeros();
+
+            // The first factorization analyzes the pattern, and the second
+            // reuses that analysis from the cache
+            SymbolicCache& cache = Calculator::getSymbolicCache();
+            SparseLU lu;
+
+            cache.clear();
+            phase[6] = timeOf([&]() { cache.factorize(system.matrix, lu); });
+            phase[7] = timeOf([&]() { cache.factorize(system.matrix, lu); });
+            result.factorNonZeros = lu.factorNonZeros();
+
+            std::vector<double> solution = system.coeff;
+            phase[8] = timeOf([&]() { lu.solve(solution); });
+            phase[9] = timeOf([&]() { Calculator::setComponentValues(system, solution, circuit.getComponents()); });
+
+            result.total = phase[1] + phase[5] + phase[6] + phase[8] + phase[9];
+        } catch (const std::exception& e) {
+            result.status = std::string("error: ") + e.what();
+        }
+
+        return result;
+    }
+
+#ifndef _WIN32
+    /**
+        Description:   Writes every measured field of a result to a pipe.
+        Return:        bool
+        Precondition:  The file descriptor is the write end of a pipe.
+        Postcondition: Returns false if the result could not be written.
+    */
+    bool sendResult(int fd, const Result& result) {
+        std::string data(result.status.size() + sizeof(int) * 5 + sizeof(result.phases) + sizeof(double), '\0');
+        char* next = &data[0];
+
+        for (int value : { result.nodes, result.components, result.unknowns, result.nonZeros,
+                           result.factorNonZeros }) {
+            std::memcpy(next, &value, sizeof(value));
+            next += sizeof(value);
+        }
+
+        std::memcpy(next, result.phases, sizeof(result.phases));
+        next += sizeof(result.phases);
+        std::memcpy(next, &result.total, sizeof(result.total));
+        next += sizeof(result.total);
+        std::memcpy(next, result.status.data(), result.status.size());
+
+        for (size_t written = 0; written < data.size(); ) {
+            ssize_t count = write(fd, data.data() + written, data.size() - written);
+            if (count <= 0)
+                return false;
+            written += size_t(count);
+        }
+
+        return true;
+    }
+
+    /**
+        Description:   Reads a result written by sendResult() from a pipe,
+                       until the pipe is closed.
+        Return:        bool
+        Precondition:  The file descriptor is the read end of a pipe.
+        Postcondition: The measured fields of the result are set. Returns
+                       false if the whole result was not received.
+    */
+    bool receiveResult(int fd, Result& result) {
+        std::string data;
+        char buffer[4096];
+        ssize_t count;
+
+        while ((count = read(fd, buffer, sizeof(buffer))) > 0)
+            data.append(buffer, size_t(count));
+
+        const size_t fixed = sizeof(int) * 5 + sizeof(result.phases) + sizeof(double);
+        if (count < 0 || data.size() <= fixed)
+            return false;
+
+        const char* next = data.data();
+
+        for (int* value : { &result.nodes, &result.components, &result.unknowns, &result.nonZeros,
+                            &result.factorNonZeros }) {
+            std::memcpy(value, next, sizeof(*value));
+            next += sizeof(*value);
+        }
+
+        std::memcpy(result.phases, next, sizeof(result.phases));
+        next += sizeof(result.phases);
+        std::memcpy(&result.total, next, sizeof(result.total));
+        next += sizeof(result.total);
+        result.status.assign(next, data.data() + data.size());
+
+        return true;
+    }
+#endif
+
+    /**
+        Description:   Generates and solves one circuit in a child process,
+                       and measures the child's peak memory. Memory freed by
+                       one case can stay resident in the process that freed
+                       it, so a case run in the benchmark's own process would
+                       count what earlier cases left behind.
+        Return:        Result
+        Precondition:  The family is one of FAMILIES.
+        Postcondition: The result is returned. If the platform cannot run
+                       the case in a child process, it is run in this one and
+                       its peak memory is left at -1. A child that does not
+                       finish is recorded as an error.
+    */
+    Result runIsolatedCase(const std::string& family, long long size, std::uint32_t seed) {
+#ifdef _WIN32
+        return runCase(family, size, seed);
+#else
+        int fds[2];
+        if (pipe(fds) != 0)
+            return runCase(family, size, seed);
+
+        pid_t child = fork();
+
+        if (child == -1) {
+            close(fds[0]);
+            close(fds[1]);
+            return runCase(family, size, seed);
+        }
+
+        if (child == 0) {
+            // The child must not flush the parent's buffered output or run
+            // its destructors, so it leaves with _exit()
+            close(fds[0]);
+            bool sent = sendResult(fds[1], runCase(family, size, seed));
+            close(fds[1]);
+            _exit(sent ? 0 : 1);
+        }
+
+        close(fds[1]);
+
+        Result result;
+        result.family = family;
+        result.size = size;
+
+        bool received = receiveResult(fds[0], result);
+        close(fds[0]);
+
+        int status = 0;
+        struct rusage resources;
+
+        if (wait4(child, &status, 0, &resources) == child) {
+#ifdef __APPLE__
+            result.peakMemory = (long long)resources.ru_maxrss;
+#else
+            result.peakMemory = (long long)resources.ru_maxrss * 1024;
+#endif
+        }
+
+        if (!received) {
+            result.status = WIFSIGNALED(status) ? "error: the case was killed by signal " +
+                                                  std::to_string(WTERMSIG(status))
+                                                : std::string("error: the case did not finish");
+        }
+
+        return result;
+#endif
+    }
+
+    /**
+        Description:   Escapes a string for a JSON or CSV string literal.
+        Return:        string
+        Precondition:  None
+        Postcondition: The quoted string is returned.
+    */
+    std::string quote(const std::string& text) {
+        std::string quoted = "\"";
+
+        for (char c : text) {
+            if (c == '"' || c == '\\')
+                quoted += '\\';
+            quoted += c < ' ' ? ' ' : c;
+        }
+
+        return quoted + "\"";
+    }
+
+    /**
+        Description:   Describes the build, so results from different builds
+                       can be told apart.
+        Return:        string
+        Precondition:  None
+        Postcondition: The description is returned as JSON object members.
+    */
+    std::string getBuildInfo() {
+        std::ostringstream info;
+
+#if defined(__clang__)
+        info << "\"compiler\": " << quote(std::string("clang ") + __clang_version__);
+#elif defined(__GNUC__)
+        info << "\"compiler\": " << quote(std::string("gcc ") + __VERSION__);
+#elif defined(_MSC_VER)
+        info << "\"compiler\": " << quote("msvc " + std::to_string(_MSC_VER));
+#else
+        info << "\"compiler\": \"unknown\"";
+#endif
+
+#ifdef NDEBUG
+        info << ", \"assertions\": false";
+#else
+        info << ", \"assertions\": true";
+#endif
+
+        // Instrumented builds are slower, so their results are not comparable
+        info << ", \"profiling\": " << (Profiler::isEnabled() ? "true" : "false");
+
+        char timestamp[32];
+        std::time_t now = std::time(nullptr);
+        std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+        info << ", \"timestamp\": " << quote(timestamp);
+
+        return info.str();
+    }
+
+    /**
+        Description:   Writes one result as a JSON object.
+        Return:        void
+        Precondition:  None
+        Postcondition: The result is written to the stream.
+    */
+    void writeJson(std::ostream& out, const Result& result) {
+        out << "    {\"family\": " << quote(result.family) << ", \"size\": " << result.size
+            << ", \"status\": " << quote(result.status) << ", \"nodes\": " << result.nodes
+            << ", \"components\": " << result.components << ", \"unknowns\": " << result.unknowns
+            << ", \"nonZeros\": " << result.nonZeros << ", \"factorNonZeros\": " << result.factorNonZeros
+            << ",\n     \"phases\": {";
+
+        for (int p = 0; p < PHASE_COUNT; p++)
+            out << (p == 0 ? "" : ", ") << quote(PHASES[p]) << ": " << result.phases[p];
+
+        out << "},\n     \"total\": " << result.total << ", \"componentsPerSecond\": "
+            << (result.total > 0.0 ? result.components / result.total : 0.0) << ", \"casePeakMemoryBytes\": ";
+
+        if (result.peakMemory < 0)
+            out << "null";
+        else
+            out << result.peakMemory;
+
+        out << "}";
+    }
+
+    /**
+        Description:   Writes one result as a line of CSV.
+        Return:        void
+        Precondition:  None
+        Postcondition: The result is written to the stream.
+    */
+    void writeCsv(std::ostream& out, const Result& result) {
+        out << result.family << ',' << result.size << ',' << quote(result.status) << ','
+            << result.nodes << ',' << result.components << ',' << result.unknowns << ','
+            << result.nonZeros << ',' << result.factorNonZeros;
+
+        for (int p = 0; p < PHASE_COUNT; p++)
+            out << ',' << result.phases[p];
+
+        out << ',' << result.total << ','
+            << (result.total > 0.0 ? result.components / result.total : 0.0) << ','
+            << result.peakMemory << '\n';
+    }
+
+    /**
+        Description:   Prints how to run the program.
+        Return:        int
+        Precondition:  None
+        Postcondition: The usage is printed, and the exit code for bad
+                       arguments is returned.
+    */
+    int usage(const char* program) {
+        std::cerr << "Usage: " << program << " [--family <name>,...] [--min-nodes <n>]"
+                  << " [--max-nodes <n>] [--budget <seconds>] [--seed <seed>]"
+                  << " [--format json|csv] [--output <file>] [--factor-target <seconds>]" << std::endl
+                  << std::endl
+                  << "  Families: ladder, mesh2d, mesh3d, random, vchain, star" << std::endl
+                  << "  Sizes go up by factors of ten. A family stops growing once the next"
+                  << " size is projected to take longer than the budget (default 10s)."
+                  << std::endl;
+        return 2;
+    }
+}
+
+int main(int argc, char** argv) {
+    std::vector<std::string> families(std::begin(FAMILIES), std::end(FAMILIES));
+    long long minNodes = 10,
+              maxNodes = 1000000;
+    double budget = 10.0,
+           factorTarget = 0.0;
+    std::uint32_t seed = 1;
+    std::string format = "json",
+                outputPath;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+
+            if (i + 1 == argc)
+                return usage(argv[0]);
+
+            if (arg == "--family") {
+                families.clear();
+                std::istringstream ss(argv[++i]);
+                std::string family;
+
+                while (std::getline(ss, family, ',')) {
+                    if (std::find(std::begin(FAMILIES), std::end(FAMILIES), family) == std::end(FAMILIES))
+                        return usage(argv[0]);
+                    families.push_back(family);
+                }
+            } else if (arg == "--min-nodes") {
+                minNodes = std::stoll(argv[++i]);
+            } else if (arg == "--max-nodes") {
+                maxNodes = std::stoll(argv[++i]);
+            } else if (arg == "--budget") {
+                budget = std::stod(argv[++i]);
+            } else if (arg == "--seed") {
+                seed = std::uint32_t(std::stoul(argv[++i]));
+            } else if (arg == "--format") {
+                format = argv[++i];
+                if (format != "json" && format != "csv")
+                    return usage(argv[0]);
+            } else if (arg == "--output") {
+                outputPath = argv[++i];
+            } else if (arg == "--factor-target") {
+                factorTarget = std::stod(argv[++i]);
+            } else {
+                return usage(argv[0]);
+            }
+        }
+    } catch (const std::exception&) {
+        return usage(argv[0]);
+    }
+
+    std::ofstream file;
+    if (!outputPath.empty()) {
+        file.open(outputPath);
+        if (!file) {
+            std::cerr << "Unable to open " << outputPath << std::endl;
+            return 1;
+        }
+    }
+
+    std::ostream& out = outputPath.empty() ? std::cout : file;
+    out.precision(9);
+
+    if (format == "json") {
+        out << "{\"build\": {" << getBuildInfo() << "},\n \"results\": [\n";
+    } else {
+        out << "family,size,status,nodes,components,unknowns,nonZeros,factorNonZeros";
+        for (int p = 0; p < PHASE_COUNT; p++)
+            out << ',' << PHASES[p];
+        out << ",total,componentsPerSecond,casePeakMemoryBytes\n";
+    }
+
+    bool first = true;
+    int status = 0;
+
+    for (const std::string& family : families) {
+        // The growth of the last two sizes predicts the time of the next one
+        double lastTime = 0.0,
+               exponent = 2.0;
+        long long lastSize = 0;
+
+        for (long long size = minNodes; size <= maxNodes; size *= 10) {
+            if (lastSize > 0 && lastTime * std::pow(double(size) / lastSize, exponent) > budget) {
+                std::cerr << family << " " << size << ": skipped, projected past the budget" << std::endl;
+                break;
+            }
+
+            std::cerr << family << " " << size << "..." << std::flush;
+            Result result = runIsolatedCase(family, size, seed);
+
+            // The first factorization includes the ordering, which is where
+            // dense rows used to make the time grow quadratically
+            if (factorTarget > 0.0 && result.status == "ok" && result.phases[6] > factorTarget) {
+                result.status = "slow";
+                status = 1;
+            }
+            std::cerr << " " << result.status << " (" << result.total << "s)" << std::endl;
+
+            if (format == "json") {
+                if (!first)
+                    out << ",\n";
+                writeJson(out, result);
+            } else {
+                writeCsv(out, result);
+            }
+
+            out.flush();
+            first = false;
+
+            double time = 0.0;
+            for (int p = 1; p < PHASE_COUNT; p++)
+                time += result.phases[p];
+
+            if (lastSize > 0 && lastTime > 0.0 && time > 0.0)
+                exponent = std::min(3.0, std::max(1.0, std::log(time / lastTime) / std::log(double(size) / lastSize)));
+
+            lastTime = time;
+            lastSize = size;
+
+            if (time > budget)
+                break;
+        }
+    }
+
+    if (format == "json")
+        out << "\n]}\n";
+
+    return status;
+}
\ No newline at end of file
@@ -0,0 +1,331 @@
+/**
+    Author:             Matthew Olsson
+    File Title:         cli.cpp
+    File Description:   Entry point for the command line simulator. Reads a
+                        circuit file (see CircuitFile.h), solves it, and
+                        prints the voltage across and current through every
+                        resistor and voltage source. No window is opened, so
+                        it can be run on headless machines. With --sweep, the
+                        circuit is instead solved for every combination of
+                        the swept values (see Sweep.h), and the results are
+                        printed as CSV. With --monte-carlo, statistics of
+                        randomized solves are printed instead (see
+                        MonteCarlo.h). With --profile or --trace, the
+                        solver's instrumentation (see Profiler.h) is written
+                        to a file afterwards. With --save, the circuit is
+                        written to a binary circuit file (see
+                        BinaryCircuitFile.h), or to a SPICE netlist (see
+                        SpiceFile.h) if the file ends in .cir, .sp or .spice,
+                        instead of being solved.
+    Date Created:       10/18/2026
+    Date Last Modified: 10/18/2026
+*/
+
+#include <algorithm>      // max
+#include <exception>      // exception class
+#include <fstream>        // ofstream class
+#include <iomanip>        // setw, setprecision, left
+#include <iostream>       // cout, cerr
+#include <map>            // map class
+#include <sstream>        // istringstream class
+#include <string>         // string, stoi, stoll, stoull
+#include <vector>         // vector class
+#include "Calculator.h"
+#include "Circuit.h"
+#include "CircuitFile.h"
+#include "MonteCarlo.h"
+#include "Profiler.h"
+#include "Sweep.h"
+
+/**
+    Description:   Prints how to run the program.
+    Return:        int
+    Precondition:  None
+    Postcondition: The usage is printed, and the exit code for bad arguments
+                   is returned.
+*/
+int usage(const char* program) {
+    std::cerr << "Usage: " << program << " <circuit file>" << std::endl
+              << "       " << program << " <circuit file> --sweep <name>=<values>..."
+              << " [--threads <count>] [--probe <name>,...]" << std::endl
+              << "       " << program << " <circuit file> --monte-carlo <trials>"
+              << " [--tolerance [<name>=]<spread>]... [--seed <seed>] [--bins <count>]"
+              << " [--threads <count>]" << std::endl
+              << "       " << program << " <circuit file> --save <file>" << std::endl
+              << std::endl
+              << "  Circuit files ending in .cir, .sp or .spice are read and written as"
+              << " SPICE netlists" << std::endl
+              << "  Any form may add --profile <file> and --trace <file> to write the"
+              << " solver's stage timings as JSON or as a trace" << std::endl
+              << "  <values> is one of lin:<start>:<stop>:<count>,"
+              << " log:<start>:<stop>:<count> or list:<v1>,<v2>,..." << std::endl
+              << "  <spread> is uniform:<fraction> or gauss:<fraction>, where the fraction"
+              << " may be a percentage (default uniform:5%)" << std::endl;
+    return 2;
+}
+
+/**
+    Description:   Solves the circuit at every point of a sweep and prints one
+                   line of CSV per point, in order. Points that cannot be
+                   solved are printed as nan.
+    Return:        int
+    Precondition:  The circuit has been loaded.
+    Postcondition: The results are printed, and the exit code is returned.
+*/
+int runSweep(const Circuit& circuit, const std::vector<SweepParameter>& parameters,
+             const std::vector<std::string>& probes, int threads) {
+    try {
+        Sweep sweep(circuit, parameters, probes);
+        std::vector<std::string> probeNames = sweep.getProbeNames();
+
+        std::cout << "point";
+        for (const SweepParameter& parameter : parameters)
+            std::cout << ',' << parameter.name;
+        for (const std::string& name : probeNames)
+            std::cout << ',' << name << ".V," << name << ".I";
+        std::cout << '\n';
+
+        std::cout << std::setprecision(9);
+
+        sweep.run(threads, [&](const SweepPoint& point) {
+            std::cout << point.index;
+
+            for (double value : point.values)
+                std::cout << ',' << value;
+
+            for (int i = 0; i < int(probeNames.size()); i++) {
+                if (point.solved)
+                    std::cout << ',' << point.voltages[i] << ',' << point.currents[i];
+                else
+                    std::cout << ",nan,nan";
+            }
+
+            std::cout << '\n';
+        });
+
+        std::cout.flush();
+    } catch (const std::exception& e) {
+        std::cerr << "Error sweeping circuit: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+    Description:   Runs a Monte Carlo analysis of the circuit and prints the
+                   statistics of every resistor and voltage source as CSV, one
+                   line per quantity. Histogram counts are separated by
+                   spaces.
+    Return:        int
+    Precondition:  The circuit has been loaded.
+    Postcondition: The results are printed, and the exit code is returned.
+*/
+int runMonteCarlo(const Circuit& circuit, long long trials, const Tolerance& tolerance,
+                  const std::map<std::string, Tolerance>& overrides, std::uint64_t seed,
+                  int bins, int threads) {
+    try {
+        MonteCarlo monteCarlo(circuit, tolerance, overrides);
+        MonteCarloResult result = monteCarlo.run(trials, seed, threads, bins);
+
+        std::cout << "# trials=" << result.trials << " failed=" << result.failed
+                  << " seed=" << seed << '\n'
+                  << "name,quantity,mean,stddev,min,max,binstart,binwidth,histogram\n"
+                  << std::setprecision(9);
+
+        for (const ComponentStatistics& component : result.components) {
+            for (int q = 0; q < 2; q++) {
+                const Statistics& statistics = q == 0 ? component.voltage : component.current;
+
+                std::cout << component.name << (q == 0 ? ",V," : ",I,") << statistics.mean
+                          << ',' << statistics.stdDev << ',' << statistics.min << ','
+                          << statistics.max << ',' << statistics.binStart << ','
+                          << statistics.binWidth << ',';
+
+                for (int b = 0; b < int(statistics.histogram.size()); b++)
+                    std::cout << (b == 0 ? "" : " ") << statistics.histogram[b];
+
+                std::cout << '\n';
+            }
+        }
+
+        std::cout.flush();
+    } catch (const std::exception& e) {
+        std::cerr << "Error analyzing circuit: " << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
+
+/**
+    Description:   Writes the profiler's results to the requested files.
+    Return:        int
+    Precondition:  None
+    Postcondition: The files are written, and the exit code is returned.
+*/
+int writeProfile(const std::string& profilePath, const std::string& tracePath) {
+    if ((!profilePath.empty() || !tracePath.empty()) && !Profiler::isEnabled())
+        std::cerr << "Warning: built without CIRCUIT_PROFILING, so nothing was recorded" << std::endl;
+
+    for (int i = 0; i < 2; i++) {
+        const std::string& path = i == 0 ? profilePath : tracePath;
+        if (path.empty())
+            continue;
+
+        std::ofstream file(path);
+        if (!file) {
+            std::cerr << "Unable to open " << path << std::endl;
+            return 1;
+        }
+
+        if (i == 0)
+            Profiler::writeJson(file);
+        else
+            Profiler::writeTrace(file);
+    }
+
+    return 0;
+}
+
+/**
+    Description:   Solves the circuit once and prints the voltage across and
+                   current through every resistor and voltage source.
+    Return:        int
+    Precondition:  The circuit has been loaded.
+    Postcondition: The results are printed, and the exit code is returned.
+*/
+int runSolve(Circuit& circuit) {
+    try {
+        if (!Calculator::calculate(circuit.getSpots(), circuit.getComponents())) {
+            std::cerr << "The circuit is incomplete" << std::endl;
+            return 1;
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Error calculating circuit values: " << e.what() << std::endl;
+        return 1;
+    }
+
+    std::cout << std::left << std::setw(12) << "Name" << std::setw(16) << "Type"
+              << std::setw(16) << "Voltage (V)" << "Current (A)" << std::endl;
+
+    const std::vector<Component*>& components = circuit.getComponents();
+
+    for (int i = 0; i < int(components.size()); i++) {
+        Component* component = components[i];
+
+        // Wires have no voltage drop, and their current is not calculated
+        if (component->type == &WIRE)
+            continue;
+
+        std::cout << std::left << std::setw(12) << circuit.getName(i)
+                  << std::setw(16) << component->type->getName()
+                  << std::setw(16) << std::setprecision(6) << component->voltageDrop
+                  << component->currentThrough << std::endl;
+    }
+
+    return 0;
+}
+
+int main(int argc, char** argv) {
+    std::string path;
+    std::vector<SweepParameter> parameters;
+    std::vector<std::string> probes;
+    int threads = 0;
+    std::string profilePath,
+                tracePath,
+                savePath;
+
+    long long trials = 0;
+    Tolerance tolerance = MonteCarlo::parseTolerance("uniform:5%");
+    std::map<std::string, Tolerance> overrides;
+    std::uint64_t seed = 1;
+    int bins = 20;
+
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+
+            bool hasValue = arg == "--sweep" || arg == "--threads" || arg == "--probe" ||
+                            arg == "--monte-carlo" || arg == "--tolerance" || arg == "--seed" ||
+                            arg == "--bins" || arg == "--profile" || arg == "--trace" ||
+                            arg == "--save";
+
+            if (hasValue && i + 1 == argc)
+                return usage(argv[0]);
+
+            if (arg == "--sweep") {
+                parameters.push_back(Sweep::parseParameter(argv[++i]));
+            } else if (arg == "--threads") {
+                threads = std::stoi(argv[++i]);
+            } else if (arg == "--probe") {
+                std::istringstream ss(argv[++i]);
+                std::string name;
+
+                while (std::getline(ss, name, ','))
+                    probes.push_back(name);
+            } else if (arg == "--monte-carlo") {
+                trials = std::stoll(argv[++i]);
+                if (trials <= 0)
+                    return usage(argv[0]);
+            } else if (arg == "--tolerance") {
+                std::string spec = argv[++i];
+                size_t equals = spec.find('=');
+
+                if (equals == std::string::npos)
+                    tolerance = MonteCarlo::parseTolerance(spec);
+                else
+                    overrides[spec.substr(0, equals)] = MonteCarlo::parseTolerance(spec.substr(equals + 1));
+            } else if (arg == "--seed") {
+                seed = std::stoull(argv[++i]);
+            } else if (arg == "--bins") {
+                bins = std::stoi(argv[++i]);
+            } else if (arg == "--profile") {
+                profilePath = argv[++i];
+            } else if (arg == "--trace") {
+                tracePath = argv[++i];
+            } else if (arg == "--save") {
+                savePath = argv[++i];
+            } else if (path.empty() && arg[0] != '-') {
+                path = arg;
+            } else {
+                return usage(argv[0]);
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << e.what() << std::endl;
+        return usage(argv[0]);
+    }
+
+    if (path.empty() || (!parameters.empty() && trials > 0) ||
+        (!savePath.empty() && (!parameters.empty() || trials > 0)))
+        return usage(argv[0]);
+
+    Circuit circuit;
+
+    try {
+        CircuitFile::load(path, circuit);
+    } catch (const std::exception& e) {
+        std::cerr << "Error loading circuit: " << e.what() << std::endl;
+        return 1;
+    }
+
+    int status;
+
+    if (!savePath.empty()) {
+        try {
+            CircuitFile::save(savePath, circuit);
+            status = 0;
+        } catch (const std::exception& e) {
+            std::cerr << "Error saving circuit: " << e.what() << std::endl;
+            status = 1;
+        }
+    } else if (!parameters.empty())
+        status = runSweep(circuit, parameters, probes, threads);
+    else if (trials > 0)
+        status = runMonteCarlo(circuit, trials, tolerance, overrides, seed, bins, threads);
+    else
+        status = runSolve(circuit);
+
+    return std::max(status, writeProfile(profilePath, tracePath));
+}
\ No newline at end of file
@@ -6,7 +6,7 @@
                             voltage sources.
 	Due Date:               4/25/2018
 	Date Created:           3/16/2018
-	Date Last Modified:     4/23/2018
+	Date Last Modified:     10/18/2026
 */
 
 #include <iostream>
@@ -16,7 +16,9 @@
 // Resolve Visual Studio linker bug by defining legacy function required
 // to compile.
 // https://stackoverflow.com/questions/30412951/unresolved-external-symbol-imp-fprintf-and-imp-iob-func-sdl2
+#ifdef _MSC_VER
 extern "C" { FILE __iob_func[3] = { *stdin, *stdout, *stderr }; }
+#endif
 
 int main() {
     // Open an instance of the application